@@ -0,0 +1,83 @@
+// Copyright 2017 Elias Kosunen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// This file is a part of scnlib:
+//     https://github.com/eliaskosunen/scnlib
+
+#ifndef SCN_BENCHMARK_ALLOC_H
+#define SCN_BENCHMARK_ALLOC_H
+
+#include "../allocations.h"
+#include "../sources.h"
+
+#include <scn/tuple_return.h>
+
+#include <limits>
+#include <string>
+#include <vector>
+
+#define ALLOC_DATA_N (static_cast<size_t>(2 << 8))
+
+// Newline-separated integers, usable for both scanning values and getline
+inline std::string alloc_data(size_t n = ALLOC_DATA_N)
+{
+    std::uniform_int_distribution<int> dist(std::numeric_limits<int>::min(),
+                                            std::numeric_limits<int>::max());
+    auto rng = make_rng();
+    std::string ret;
+    for (size_t i = 0; i < n; ++i) {
+        ret += std::to_string(dist(rng));
+        ret.push_back('\n');
+    }
+    return ret;
+}
+
+// Runs Scanner over the whole source on every iteration, and reports the
+// allocations made per scanned value.
+// The first run is not counted, so that one-time allocations don't show up.
+template <typename Source, typename Scanner>
+void run_alloc_benchmark(benchmark::State& state)
+{
+    Source source{alloc_data()};
+    Scanner scanner{};
+
+    size_t values = 0;
+    if (!scanner.run(source.range(), values)) {
+        state.SkipWithError("Benchmark errored");
+        return;
+    }
+    source.reset();
+
+    values = 0;
+    allocation_counter counter{};
+    for (auto _ : state) {
+        if (!scanner.run(source.range(), values)) {
+            state.SkipWithError("Benchmark errored");
+            break;
+        }
+        source.reset();
+    }
+    const auto allocs = counter.get();
+
+    const auto per_value = [&](size_t n) {
+        return values == 0
+                   ? 0.0
+                   : static_cast<double>(n) / static_cast<double>(values);
+    };
+    state.counters["allocs_per_value"] = per_value(allocs.count);
+    state.counters["alloc_bytes_per_value"] = per_value(allocs.bytes);
+    state.SetItemsProcessed(static_cast<int64_t>(values));
+}
+
+#endif  // SCN_BENCHMARK_ALLOC_H
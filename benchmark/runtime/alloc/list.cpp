@@ -0,0 +1,69 @@
+// Copyright 2017 Elias Kosunen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// This file is a part of scnlib:
+//     https://github.com/eliaskosunen/scnlib
+
+#include "bench_alloc.h"
+
+// The containers are kept between runs, so that only the allocations made by
+// scnlib itself are counted
+
+struct scan_list_scanner {
+    template <typename Range>
+    bool run(Range&& range, size_t& values)
+    {
+        read.clear();
+        auto result = scn::scan_list(SCN_FWD(range), read);
+        if (!result) {
+            return false;
+        }
+        values += read.size();
+        return true;
+    }
+
+    std::vector<int> read{};
+};
+
+template <typename Source>
+static void alloc_scan_list(benchmark::State& state)
+{
+    run_alloc_benchmark<Source, scan_list_scanner>(state);
+}
+BENCHMARK_ALL_SOURCES(alloc_scan_list);
+
+struct getline_scanner {
+    template <typename Range>
+    bool run(Range&& range, size_t& values)
+    {
+        auto result = scn::make_result(SCN_FWD(range));
+        while (true) {
+            result = scn::getline(result.range(), line);
+            if (!result) {
+                return result.error() == scn::error::end_of_range;
+            }
+            benchmark::DoNotOptimize(line.data());
+            ++values;
+        }
+    }
+
+    std::string line{};
+};
+
+template <typename Source>
+static void alloc_getline(benchmark::State& state)
+{
+    run_alloc_benchmark<Source, getline_scanner>(state);
+}
+BENCHMARK_ALL_SOURCES(alloc_getline);
@@ -0,0 +1,113 @@
+// Copyright 2017 Elias Kosunen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// This file is a part of scnlib:
+//     https://github.com/eliaskosunen/scnlib
+
+#include "bench_alloc.h"
+
+struct scan_scanner {
+    template <typename Range>
+    bool run(Range&& range, size_t& values)
+    {
+        auto result = scn::make_result(SCN_FWD(range));
+        int i{};
+        while (true) {
+            result = scn::scan(result.range(), "{}", i);
+            if (!result) {
+                return result.error() == scn::error::end_of_range;
+            }
+            benchmark::DoNotOptimize(i);
+            ++values;
+        }
+    }
+};
+
+template <typename Source>
+static void alloc_scan(benchmark::State& state)
+{
+    run_alloc_benchmark<Source, scan_scanner>(state);
+}
+BENCHMARK_ALL_SOURCES(alloc_scan);
+
+struct scan_default_scanner {
+    template <typename Range>
+    bool run(Range&& range, size_t& values)
+    {
+        auto result = scn::make_result(SCN_FWD(range));
+        int i{};
+        while (true) {
+            result = scn::scan_default(result.range(), i);
+            if (!result) {
+                return result.error() == scn::error::end_of_range;
+            }
+            benchmark::DoNotOptimize(i);
+            ++values;
+        }
+    }
+};
+
+template <typename Source>
+static void alloc_scan_default(benchmark::State& state)
+{
+    run_alloc_benchmark<Source, scan_default_scanner>(state);
+}
+BENCHMARK_ALL_SOURCES(alloc_scan_default);
+
+struct scan_value_scanner {
+    template <typename Range>
+    bool run(Range&& range, size_t& values)
+    {
+        auto result = scn::make_result<scn::expected<int>>(SCN_FWD(range));
+        while (true) {
+            result = scn::scan_value<int>(result.range());
+            if (!result) {
+                return result.error() == scn::error::end_of_range;
+            }
+            benchmark::DoNotOptimize(result.value());
+            ++values;
+        }
+    }
+};
+
+template <typename Source>
+static void alloc_scan_value(benchmark::State& state)
+{
+    run_alloc_benchmark<Source, scan_value_scanner>(state);
+}
+BENCHMARK_ALL_SOURCES(alloc_scan_value);
+
+struct scan_tuple_scanner {
+    template <typename Range>
+    bool run(Range&& range, size_t& values)
+    {
+        auto result = scn::make_result(SCN_FWD(range));
+        int i{};
+        while (true) {
+            std::tie(result, i) = scn::scan_tuple<int>(result.range(), "{}");
+            if (!result) {
+                return result.error() == scn::error::end_of_range;
+            }
+            benchmark::DoNotOptimize(i);
+            ++values;
+        }
+    }
+};
+
+template <typename Source>
+static void alloc_scan_tuple(benchmark::State& state)
+{
+    run_alloc_benchmark<Source, scan_tuple_scanner>(state);
+}
+BENCHMARK_ALL_SOURCES(alloc_scan_tuple);
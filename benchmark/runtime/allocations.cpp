@@ -0,0 +1,96 @@
+// Copyright 2017 Elias Kosunen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// This file is a part of scnlib:
+//     https://github.com/eliaskosunen/scnlib
+
+#include "allocations.h"
+
+#include <scn/detail/config.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// Every allocation made through the global operator new is counted,
+// including the over-aligned ones.
+// The array and nothrow forms of operator new forward to these by default.
+
+static std::atomic<size_t> allocation_count{0};
+static std::atomic<size_t> allocation_bytes{0};
+
+allocation_totals get_allocation_totals()
+{
+    return {allocation_count.load(std::memory_order_relaxed),
+            allocation_bytes.load(std::memory_order_relaxed)};
+}
+
+static void count_allocation(size_t size)
+{
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    allocation_bytes.fetch_add(size, std::memory_order_relaxed);
+}
+
+void* operator new(size_t size)
+{
+    count_allocation(size);
+    if (auto p = std::malloc(size == 0 ? 1 : size)) {
+        return p;
+    }
+    throw std::bad_alloc{};
+}
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+void operator delete(void* p, size_t) noexcept
+{
+    std::free(p);
+}
+
+#ifdef __cpp_aligned_new
+void* operator new(size_t size, std::align_val_t al)
+{
+    count_allocation(size);
+    const auto alignment = static_cast<size_t>(al);
+    if (size == 0) {
+        size = 1;
+    }
+#if SCN_WINDOWS
+    if (auto p = _aligned_malloc(size, alignment)) {
+        return p;
+    }
+#else
+    void* p = nullptr;
+    if (posix_memalign(&p,
+                       alignment < sizeof(void*) ? sizeof(void*) : alignment,
+                       size) == 0) {
+        return p;
+    }
+#endif
+    throw std::bad_alloc{};
+}
+void operator delete(void* p, std::align_val_t) noexcept
+{
+#if SCN_WINDOWS
+    _aligned_free(p);
+#else
+    std::free(p);
+#endif
+}
+void operator delete(void* p, size_t, std::align_val_t al) noexcept
+{
+    operator delete(p, al);
+}
+#endif
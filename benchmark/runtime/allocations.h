@@ -0,0 +1,47 @@
+// Copyright 2017 Elias Kosunen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// This file is a part of scnlib:
+//     https://github.com/eliaskosunen/scnlib
+
+#ifndef SCN_BENCHMARK_ALLOCATIONS_H
+#define SCN_BENCHMARK_ALLOCATIONS_H
+
+#include <cstddef>
+
+// Totals of the allocations made through the global operator new,
+// replaced in allocations.cpp.
+// Memory allocated with malloc directly, like the buffers of C stdio
+// streams, is not counted.
+struct allocation_totals {
+    size_t count;
+    size_t bytes;
+};
+allocation_totals get_allocation_totals();
+
+class allocation_counter {
+public:
+    allocation_counter() : m_start(get_allocation_totals()) {}
+
+    allocation_totals get() const
+    {
+        const auto now = get_allocation_totals();
+        return {now.count - m_start.count, now.bytes - m_start.bytes};
+    }
+
+private:
+    allocation_totals m_start;
+};
+
+#endif  // SCN_BENCHMARK_ALLOCATIONS_H
@@ -23,14 +23,126 @@ SCN_GCC_IGNORE("-Wredundant-decls")
 
 #include <benchmark/benchmark.h>
 
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
 #include <random>
+#include <string>
+#include <vector>
 
-inline std::mt19937_64& get_rng()
+// Benchmark data is generated from a fixed seed, so that every run scans the
+// same input. Set SCN_BENCHMARK_SEED to use a different one.
+inline std::uint64_t get_benchmark_seed()
 {
-    static std::random_device rd;
-    static std::seed_seq seed{rd(), rd(), rd(), rd(), rd(), rd(), rd(), rd()};
-    static std::mt19937_64 rng(seed);
-    return rng;
+    static const std::uint64_t seed = [] {
+        if (const char* env = std::getenv("SCN_BENCHMARK_SEED")) {
+            return static_cast<std::uint64_t>(std::strtoull(env, nullptr, 0));
+        }
+        return std::uint64_t{0x5c2017};
+    }();
+    return seed;
+}
+
+// Returns a generator seeded with the benchmark seed.
+// Every data generator uses a fresh one, so the data doesn't depend on
+// which benchmarks were run before it (e.g. with --benchmark_filter).
+inline std::mt19937_64 make_rng()
+{
+    return std::mt19937_64{get_benchmark_seed()};
+}
+
+// If SCN_BENCHMARK_CORPUS_DIR is set, corpora are read from
+// `<dir>/<name>.txt`, and generated and written there if they don't exist.
+// Point a before- and an after-build to the same directory to scan
+// identical input with both, regardless of the standard library's
+// distributions.
+inline const char* get_corpus_dir()
+{
+    static const char* dir = [] {
+        const char* env = std::getenv("SCN_BENCHMARK_CORPUS_DIR");
+        return (env && *env) ? env : nullptr;
+    }();
+    return dir;
+}
+
+inline bool read_corpus_file(const std::string& path, std::string& out)
+{
+    auto f = std::fopen(path.c_str(), "rb");
+    if (!f) {
+        return false;
+    }
+    out.clear();
+    char buf[4096];
+    size_t n;
+    while ((n = std::fread(buf, 1, sizeof(buf), f)) != 0) {
+        out.append(buf, n);
+    }
+    std::fclose(f);
+    return true;
+}
+inline void write_corpus_file(const std::string& path, const std::string& data)
+{
+    auto f = std::fopen(path.c_str(), "wb");
+    if (!f) {
+        std::fprintf(stderr, "Failed to write benchmark corpus to %s\n",
+                     path.c_str());
+        return;
+    }
+    std::fwrite(data.data(), 1, data.size(), f);
+    std::fclose(f);
+}
+
+// Returns the corpus called `name`: `generate(rng)` is only called if it
+// isn't found in the corpus directory.
+template <typename Generate>
+std::string load_corpus(const std::string& name, Generate generate)
+{
+    const auto dir = get_corpus_dir();
+    if (!dir) {
+        auto rng = make_rng();
+        return generate(rng);
+    }
+
+    const auto path = std::string{dir} + "/" + name + ".txt";
+    std::string ret;
+    if (read_corpus_file(path, ret)) {
+        return ret;
+    }
+    auto rng = make_rng();
+    ret = generate(rng);
+    write_corpus_file(path, ret);
+    return ret;
+}
+
+// Corpora of values are stored one value per line
+inline std::vector<std::string> split_corpus_lines(const std::string& corpus)
+{
+    std::vector<std::string> ret;
+    std::string::size_type begin = 0;
+    while (begin < corpus.size()) {
+        auto end = corpus.find('\n', begin);
+        if (end == std::string::npos) {
+            end = corpus.size();
+        }
+        ret.emplace_back(corpus, begin, end - begin);
+        begin = end + 1;
+    }
+    return ret;
+}
+inline std::string join_corpus_lines(const std::string& corpus,
+                                     const char* delim)
+{
+    std::string ret;
+    ret.reserve(corpus.size());
+    for (auto ch : corpus) {
+        if (ch == '\n') {
+            ret += delim;
+        }
+        else {
+            ret.push_back(ch);
+        }
+    }
+    return ret;
 }
 
 SCN_GCC_POP
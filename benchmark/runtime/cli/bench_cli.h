@@ -0,0 +1,133 @@
+// Copyright 2017 Elias Kosunen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// This file is a part of scnlib:
+//     https://github.com/eliaskosunen/scnlib
+
+#ifndef SCN_BENCHMARK_CLI_H
+#define SCN_BENCHMARK_CLI_H
+
+#include "../allocations.h"
+#include "../sources.h"
+
+#include <scn/scn.h>
+
+#include <array>
+#include <string>
+#include <variant>
+#include <vector>
+
+// A field of a record, its type given with --types
+using cli_field = std::variant<int,
+                               long long,
+                               unsigned,
+                               unsigned long long,
+                               float,
+                               double,
+                               long double,
+                               char,
+                               bool,
+                               std::string,
+                               scn::string_view>;
+
+// Returns false if `name` isn't a known field type
+bool make_cli_field(const std::string& name, cli_field& field);
+
+// Every scanned line (or whatever the format string matches) is read into
+// a record: the fields are scanned with the format string given with
+// --format, through the type-erased scn::vscan_usertype.
+struct cli_record {
+    static constexpr size_t max_fields = 32;
+
+    std::vector<cli_field> fields;
+    scn::string_view format;
+    // Lines skipped after an error are read here
+    std::string skipped;
+};
+
+namespace scn {
+    template <>
+    struct scanner<cli_record> : public empty_parser {
+        template <typename Context>
+        error scan(cli_record& val, Context& ctx)
+        {
+            using char_type = typename Context::char_type;
+            using pctx_type =
+                basic_parse_context<typename Context::locale_type>;
+
+            std::array<basic_arg<char_type>, cli_record::max_fields> args{};
+            for (size_t i = 0; i < val.fields.size(); ++i) {
+                args[i] = std::visit(
+                    [](auto& f) noexcept {
+                        return detail::make_arg<Context, pctx_type>(f);
+                    },
+                    val.fields[i]);
+            }
+            return vscan_usertype(
+                ctx, val.format,
+                basic_args<char_type>{
+                    span<basic_arg<char_type>>{args.data(),
+                                               val.fields.size()}});
+        }
+    };
+}  // namespace scn
+
+struct cli_pass_totals {
+    size_t records{0};
+    size_t errors{0};
+};
+
+inline bool is_blank(const std::string& str)
+{
+    for (auto ch : str) {
+        if (ch != ' ' && ch != '\t' && ch != '\r') {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Scans all of `source.range()` into `rec`, record by record.
+// A record that fails to scan is counted as an error, and the rest of its
+// line is skipped.
+template <typename Range>
+bool run_cli_pass(Range&& range, cli_record& rec, cli_pass_totals& totals)
+{
+    auto result = scn::make_result(range);
+    while (true) {
+        result = scn::scan_default(result.range(), rec);
+        if (result) {
+            ++totals.records;
+            continue;
+        }
+        if (result.error().code() == scn::error::end_of_range) {
+            return true;
+        }
+        if (!result.error().is_recoverable()) {
+            return false;
+        }
+        ++totals.errors;
+        // A failed scan rolls back to the end of the previous record,
+        // i.e. usually right before its newline: skip blank lines until
+        // the failed line itself has been read
+        do {
+            result = scn::getline(result.range(), rec.skipped);
+        } while (result && is_blank(rec.skipped));
+        if (!result) {
+            return result.error().code() == scn::error::end_of_range;
+        }
+    }
+}
+
+#endif  // SCN_BENCHMARK_CLI_H
@@ -0,0 +1,345 @@
+// Copyright 2017 Elias Kosunen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// This file is a part of scnlib:
+//     https://github.com/eliaskosunen/scnlib
+
+// scn-bench: scans a file with a given format string and argument types,
+// and reports the throughput, records per second, allocations and errors.
+//
+//   scn-bench [--format=FMT] --types=T[,T...] [--source=KIND]
+//             [--min-time=SECONDS] [--iterations=N] FILE
+//
+// See --help for the accepted types and sources.
+
+#include "bench_cli.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+
+bool make_cli_field(const std::string& name, cli_field& field)
+{
+    if (name == "int") {
+        field.emplace<int>();
+    }
+    else if (name == "long_long") {
+        field.emplace<long long>();
+    }
+    else if (name == "unsigned") {
+        field.emplace<unsigned>();
+    }
+    else if (name == "unsigned_long_long") {
+        field.emplace<unsigned long long>();
+    }
+    else if (name == "float") {
+        field.emplace<float>();
+    }
+    else if (name == "double") {
+        field.emplace<double>();
+    }
+    else if (name == "long_double") {
+        field.emplace<long double>();
+    }
+    else if (name == "char") {
+        field.emplace<char>();
+    }
+    else if (name == "bool") {
+        field.emplace<bool>();
+    }
+    else if (name == "string") {
+        field.emplace<std::string>();
+    }
+    else if (name == "string_view") {
+        field.emplace<scn::string_view>();
+    }
+    else {
+        return false;
+    }
+    return true;
+}
+
+namespace {
+    struct cli_options {
+        std::string path;
+        std::string format;
+        std::string source{"mapped_file"};
+        std::vector<std::string> types;
+        double min_time{1.0};
+        size_t iterations{0};
+    };
+
+    void print_usage(const char* argv0)
+    {
+        std::printf(
+            "Usage: %s [options] FILE\n"
+            "\n"
+            "Scans FILE repeatedly, record by record, and reports the "
+            "throughput,\n"
+            "records per second, allocations and errors.\n"
+            "\n"
+            "Options:\n"
+            "  --types=T[,T...]    Types of the fields of a record "
+            "(required):\n"
+            "                      int, long_long, unsigned, "
+            "unsigned_long_long,\n"
+            "                      float, double, long_double, char, bool,\n"
+            "                      string, string_view\n"
+            "  --format=FMT        Format string of a record (default: "
+            "\"{} {} ...\")\n"
+            "  --source=KIND       string, mapped_file, file or stdin "
+            "(default: mapped_file)\n"
+            "                      stdin is scanned once, FILE is ignored\n"
+            "  --min-time=SECONDS  Minimum time to run for (default: 1)\n"
+            "  --iterations=N      Run exactly N passes over the input\n",
+            argv0);
+    }
+
+    size_t file_size(const std::string& path)
+    {
+        auto f = std::fopen(path.c_str(), "rb");
+        if (!f) {
+            return 0;
+        }
+        std::fseek(f, 0, SEEK_END);
+        const auto size = std::ftell(f);
+        std::fclose(f);
+        return size < 0 ? 0 : static_cast<size_t>(size);
+    }
+
+    bool starts_with(const char* arg, const char* prefix, const char*& value)
+    {
+        const auto len = std::strlen(prefix);
+        if (std::strncmp(arg, prefix, len) != 0) {
+            return false;
+        }
+        value = arg + len;
+        return true;
+    }
+
+    std::vector<std::string> split_types(const char* list)
+    {
+        std::vector<std::string> ret;
+        std::string cur;
+        for (; *list != '\0'; ++list) {
+            if (*list == ',') {
+                ret.push_back(cur);
+                cur.clear();
+            }
+            else {
+                cur.push_back(*list);
+            }
+        }
+        ret.push_back(cur);
+        return ret;
+    }
+
+    bool parse_options(int argc, char** argv, cli_options& opt)
+    {
+        for (int i = 1; i < argc; ++i) {
+            const char* value = nullptr;
+            if (std::strcmp(argv[i], "--help") == 0 ||
+                std::strcmp(argv[i], "-h") == 0) {
+                return false;
+            }
+            if (starts_with(argv[i], "--types=", value)) {
+                opt.types = split_types(value);
+            }
+            else if (starts_with(argv[i], "--format=", value)) {
+                opt.format = value;
+            }
+            else if (starts_with(argv[i], "--source=", value)) {
+                opt.source = value;
+            }
+            else if (starts_with(argv[i], "--min-time=", value)) {
+                opt.min_time = std::strtod(value, nullptr);
+            }
+            else if (starts_with(argv[i], "--iterations=", value)) {
+                opt.iterations =
+                    static_cast<size_t>(std::strtoull(value, nullptr, 10));
+            }
+            else if (argv[i][0] == '-' && argv[i][1] == '-') {
+                std::fprintf(stderr, "Unknown option: %s\n", argv[i]);
+                return false;
+            }
+            else {
+                opt.path = argv[i];
+            }
+        }
+        return true;
+    }
+}  // namespace
+
+namespace {
+    int open_failed(const cli_options& opt)
+    {
+        std::fprintf(stderr, "Failed to open %s\n", opt.path.c_str());
+        return 1;
+    }
+
+    template <typename Source>
+    int run_cli(const cli_options& opt, cli_record& rec, Source& source)
+    {
+        // stdin can only be scanned once
+        constexpr bool repeatable = !std::is_same<Source, stdin_source>::value;
+        using wrapped_type = scn::range_wrapper_for_t<decltype(source.range())>;
+        if (!wrapped_type::is_contiguous) {
+            for (auto& f : rec.fields) {
+                if (std::holds_alternative<scn::string_view>(f)) {
+                    std::fprintf(stderr,
+                                 "string_view can only be scanned from the "
+                                 "string and mapped_file sources\n");
+                    return 1;
+                }
+            }
+        }
+
+        cli_pass_totals totals{};
+        if (repeatable) {
+            // Warm up the page cache and the scanners' buffers:
+            // the first pass is not counted
+            if (!run_cli_pass(source.range(), rec, totals)) {
+                std::fprintf(stderr, "Unrecoverable error while scanning\n");
+                return 1;
+            }
+            source.reset();
+            totals = cli_pass_totals{};
+        }
+
+        using clock = std::chrono::steady_clock;
+        size_t passes = 0;
+        const auto allocs_start = get_allocation_totals();
+#if SCN_ENABLE_STATS
+        scn::reset_scan_stats();
+#endif
+        const auto start = clock::now();
+        auto elapsed = [&]() {
+            return std::chrono::duration<double>(clock::now() - start).count();
+        };
+        while (true) {
+            if (!run_cli_pass(source.range(), rec, totals)) {
+                std::fprintf(stderr, "Unrecoverable error while scanning\n");
+                return 1;
+            }
+            source.reset();
+            ++passes;
+
+            if (!repeatable) {
+                break;
+            }
+            if (opt.iterations != 0 ? passes >= opt.iterations
+                                    : elapsed() >= opt.min_time) {
+                break;
+            }
+        }
+        const auto seconds = elapsed();
+        const auto allocs_end = get_allocation_totals();
+
+        const auto bytes =
+            static_cast<double>(repeatable ? file_size(opt.path) : 0) *
+            static_cast<double>(passes);
+        const auto records = static_cast<double>(totals.records);
+        const auto per_record = [&](size_t n) {
+            return totals.records == 0 ? 0.0
+                                       : static_cast<double>(n) / records;
+        };
+
+        std::printf("source:          %s\n", opt.source.c_str());
+        std::printf("format:          %s\n", opt.format.c_str());
+        std::printf("passes:          %zu\n", passes);
+        std::printf("time:            %.3f s\n", seconds);
+        if (bytes > 0) {
+            std::printf("throughput:      %.2f MiB/s\n",
+                        bytes / seconds / (1024.0 * 1024.0));
+        }
+        std::printf("records:         %zu per pass\n", totals.records / passes);
+        std::printf("records/s:       %.0f\n", records / seconds);
+        std::printf("errors:          %zu per pass\n", totals.errors / passes);
+        std::printf("allocations:     %.3f per record (%.1f bytes)\n",
+                    per_record(allocs_end.count - allocs_start.count),
+                    per_record(allocs_end.bytes - allocs_start.bytes));
+#if SCN_ENABLE_STATS
+        const auto stats = scn::get_scan_stats();
+        std::printf("putbacks:        %.3f per record\n",
+                    per_record(static_cast<size_t>(stats.putback_calls)));
+        std::printf("rollbacks:       %.3f per record\n",
+                    per_record(static_cast<size_t>(stats.rollbacks)));
+        const auto float_fallbacks =
+            stats.strtod_fallbacks + stats.from_chars_fallbacks;
+        std::printf("float fallbacks: %.3f per record\n",
+                    per_record(static_cast<size_t>(float_fallbacks)));
+#endif
+        return 0;
+    }
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    cli_options opt{};
+    if (!parse_options(argc, argv, opt) || opt.types.empty() ||
+        (opt.path.empty() && opt.source != "stdin")) {
+        print_usage(argv[0]);
+        return 2;
+    }
+    if (opt.types.size() > cli_record::max_fields) {
+        std::fprintf(stderr, "At most %zu types are supported\n",
+                     cli_record::max_fields);
+        return 2;
+    }
+
+    cli_record rec{};
+    for (const auto& t : opt.types) {
+        cli_field f{};
+        if (!make_cli_field(t, f)) {
+            std::fprintf(stderr, "Unknown type: %s\n", t.c_str());
+            return 2;
+        }
+        rec.fields.push_back(std::move(f));
+    }
+    if (opt.format.empty()) {
+        for (size_t i = 0; i < rec.fields.size(); ++i) {
+            opt.format += i == 0 ? "{}" : " {}";
+        }
+    }
+    rec.format = {opt.format.data(), opt.format.size()};
+
+    if (opt.source == "string") {
+        std::string data;
+        if (!read_corpus_file(opt.path, data)) {
+            return open_failed(opt);
+        }
+        string_view_source source{std::move(data)};
+        return run_cli(opt, rec, source);
+    }
+    if (opt.source == "mapped_file") {
+        path_mapped_file_source source{opt.path};
+        if (!source.valid()) {
+            return open_failed(opt);
+        }
+        return run_cli(opt, rec, source);
+    }
+    if (opt.source == "file") {
+        path_file_source source{opt.path};
+        if (!source.valid()) {
+            return open_failed(opt);
+        }
+        return run_cli(opt, rec, source);
+    }
+    if (opt.source == "stdin") {
+        stdin_source source{};
+        return run_cli(opt, rec, source);
+    }
+    std::fprintf(stderr, "Unknown source: %s\n", opt.source.c_str());
+    return 2;
+}
@@ -24,41 +24,98 @@
 #include <cstdio>
 #include <limits>
 #include <sstream>
+#include <string>
 #include <vector>
 
 #define FLOAT_DATA_N (static_cast<size_t>(2 << 12))
 
 template <typename T>
-T generate_single_float()
+T generate_single_float(std::mt19937_64& rng)
 {
-    static std::uniform_int_distribution<int> int_dist(-16, 16);
-    static std::uniform_real_distribution<T> float_dist(T(0.0), T(1.0));
-    auto f = float_dist(get_rng());
-    auto exp = int_dist(get_rng());
+    std::uniform_int_distribution<int> int_dist(-16, 16);
+    std::uniform_real_distribution<T> float_dist(T(0.0), T(1.0));
+    auto f = float_dist(rng);
+    auto exp = int_dist(rng);
     return std::scalbn(f, exp);
 }
 
+// Corpus name for `n` values of type Float, e.g. "float-f64-8192"
+template <typename Float>
+std::string float_corpus_name(const char* kind, size_t n)
+{
+    return std::string{kind} + "-f" + std::to_string(sizeof(Float) * 8) +
+           "-" + std::to_string(n);
+}
+
+// `n` floats in [0, 1), scaled by 2^[-16, 16], one per line
+template <typename Float>
+std::string float_corpus(size_t n = FLOAT_DATA_N)
+{
+    return load_corpus(float_corpus_name<Float>("float", n),
+                       [n](std::mt19937_64& rng) {
+                           std::ostringstream oss;
+                           for (size_t i = 0; i < n; ++i) {
+                               oss << generate_single_float<Float>(rng)
+                                   << '\n';
+                           }
+                           return oss.str();
+                       });
+}
+
+// `n` floats, one per line, with the decimal exponent uniformly distributed
+// over the whole range of Float, written alternately in the fixed,
+// scientific and general formats, with full precision
+template <typename Float>
+std::string wide_exponent_float_corpus(size_t n = FLOAT_DATA_N)
+{
+    return load_corpus(
+        float_corpus_name<Float>("float-wide-exponent", n),
+        [n](std::mt19937_64& rng) {
+            // stay clear of subnormals and infinity
+            std::uniform_int_distribution<int> exp_dist(
+                std::numeric_limits<Float>::min_exponent10 + 1,
+                std::numeric_limits<Float>::max_exponent10 - 1);
+            std::uniform_real_distribution<Float> mantissa_dist(Float(1.0),
+                                                                Float(10.0));
+            std::bernoulli_distribution negative{};
+
+            std::ostringstream oss;
+            oss.precision(std::numeric_limits<Float>::max_digits10);
+            for (size_t i = 0; i < n; ++i) {
+                const auto exp = static_cast<Float>(exp_dist(rng));
+                auto f = mantissa_dist(rng) * std::pow(Float(10.0), exp);
+                if (negative(rng)) {
+                    f = -f;
+                }
+                // fixed notation is unwieldy for large exponents
+                const bool fixed_ok = std::abs(f) < Float(1e16) &&
+                                      std::abs(f) > Float(1e-16);
+                if (i % 3 == 0 && fixed_ok) {
+                    oss << std::fixed << f;
+                }
+                else if (i % 3 != 2) {
+                    oss << std::scientific << f;
+                }
+                else {
+                    oss << std::defaultfloat << f;
+                }
+                oss << '\n';
+            }
+            return oss.str();
+        });
+}
+
 template <typename Float>
 std::vector<std::string> stringified_floats_list(size_t n = FLOAT_DATA_N)
 {
-    std::vector<std::string> ret;
-    for (size_t i = 0; i < n; ++i) {
-        std::ostringstream oss;
-        oss << generate_single_float<Float>();
-        ret.push_back(std::move(oss).str());
-    }
-    return ret;
+    return split_corpus_lines(float_corpus<Float>(n));
 }
 
 template <typename Float>
 std::string stringified_float_list(size_t n = FLOAT_DATA_N,
                                    const char* delim = " ")
 {
-    std::ostringstream oss;
-    for (size_t i = 0; i < n; ++i) {
-        oss << generate_single_float<Float>() << delim;
-    }
-    return oss.str();
+    return join_corpus_lines(float_corpus<Float>(n), delim);
 }
 
 inline int scanf_float(const char* ptr, float& f)
@@ -0,0 +1,69 @@
+// Copyright 2017 Elias Kosunen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// This file is a part of scnlib:
+//     https://github.com/eliaskosunen/scnlib
+
+#include "bench_float.h"
+
+// Floats with exponents spanning the whole range of the type, in fixed,
+// scientific and general notation, and with full precision
+
+template <typename Float>
+static void scan_float_wide_exponent_scn(benchmark::State& state)
+{
+    auto data = wide_exponent_float_corpus<Float>();
+    Float f{};
+    auto result = scn::make_result(data);
+    for (auto _ : state) {
+        result = scn::scan_default(result.range(), f);
+
+        if (!result) {
+            if (result.error() == scn::error::end_of_range) {
+                result = scn::make_result(data);
+            }
+            else {
+                state.SkipWithError("Benchmark errored");
+                break;
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(scan_float_wide_exponent_scn, float);
+BENCHMARK_TEMPLATE(scan_float_wide_exponent_scn, double);
+BENCHMARK_TEMPLATE(scan_float_wide_exponent_scn, long double);
+
+template <typename Float>
+static void scan_float_wide_exponent_sstream(benchmark::State& state)
+{
+    auto data = wide_exponent_float_corpus<Float>();
+    auto stream = std::istringstream(data);
+    Float f{};
+    for (auto _ : state) {
+        stream >> f;
+
+        if (stream.eof()) {
+            stream = std::istringstream(data);
+        }
+        else if (stream.fail()) {
+            state.SkipWithError("Benchmark errored");
+            break;
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(scan_float_wide_exponent_sstream, float);
+BENCHMARK_TEMPLATE(scan_float_wide_exponent_sstream, double);
+BENCHMARK_TEMPLATE(scan_float_wide_exponent_sstream, long double);
@@ -23,36 +23,117 @@
 #include <cstdio>
 #include <limits>
 #include <sstream>
+#include <string>
+#include <type_traits>
 #include <vector>
 
 #define INT_DATA_N (static_cast<size_t>(2 << 12))
 
+// Corpus name for `n` values of type Int, e.g. "int-i32-8192"
+template <typename Int>
+std::string int_corpus_name(const char* kind, size_t n)
+{
+    return std::string{kind} + (std::is_signed<Int>::value ? "-i" : "-u") +
+           std::to_string(sizeof(Int) * 8) + "-" + std::to_string(n);
+}
+
+// `n` integers uniformly distributed over the whole range of Int,
+// one per line. Most of these have the maximum number of digits.
+template <typename Int>
+std::string integer_corpus(size_t n = INT_DATA_N)
+{
+    return load_corpus(
+        int_corpus_name<Int>("int", n),
+        [n](std::mt19937_64& rng) {
+            std::uniform_int_distribution<Int> dist(
+                std::numeric_limits<Int>::min(),
+                std::numeric_limits<Int>::max());
+
+            std::ostringstream oss;
+            for (size_t i = 0; i < n; ++i) {
+                oss << dist(rng) << '\n';
+            }
+            return oss.str();
+        });
+}
+
+// `n` integers, with the number of digits uniformly distributed
+// between 1 and the maximum for Int, one per line
+template <typename Int>
+std::string uniform_length_integer_corpus(size_t n = INT_DATA_N)
+{
+    return load_corpus(
+        int_corpus_name<Int>("int-uniform-length", n),
+        [n](std::mt19937_64& rng) {
+            // digits10 is the number of digits that can always be
+            // represented, so this never overflows
+            std::uniform_int_distribution<int> length(
+                1, std::numeric_limits<Int>::digits10);
+            std::uniform_int_distribution<int> digit(0, 9);
+            std::bernoulli_distribution negative(
+                std::is_signed<Int>::value ? 0.5 : 0.0);
+
+            std::string ret;
+            for (size_t i = 0; i < n; ++i) {
+                const auto len = length(rng);
+                if (negative(rng)) {
+                    ret.push_back('-');
+                }
+                // no leading zeroes
+                ret.push_back(static_cast<char>('1' + digit(rng) % 9));
+                for (int j = 1; j < len; ++j) {
+                    ret.push_back(static_cast<char>('0' + digit(rng)));
+                }
+                ret.push_back('\n');
+            }
+            return ret;
+        });
+}
+
+// `n` tokens, one per line, of which about `malformed_percent` percent
+// are not valid integers, or overflow Int
+template <typename Int>
+std::string malformed_integer_corpus(size_t n = INT_DATA_N,
+                                     int malformed_percent = 10)
+{
+    return load_corpus(
+        int_corpus_name<Int>("int-malformed", n) + "-" +
+            std::to_string(malformed_percent),
+        [n, malformed_percent](std::mt19937_64& rng) {
+            static const char* const malformed[] = {
+                "-", "+", "abc", "x12", "--5", "+-3", "0x", ".5",
+                "99999999999999999999999", "-99999999999999999999999"};
+            std::uniform_int_distribution<int> percent(0, 99);
+            std::uniform_int_distribution<size_t> which(
+                0, sizeof(malformed) / sizeof(malformed[0]) - 1);
+            std::uniform_int_distribution<Int> dist(
+                std::numeric_limits<Int>::min(),
+                std::numeric_limits<Int>::max());
+
+            std::ostringstream oss;
+            for (size_t i = 0; i < n; ++i) {
+                if (percent(rng) < malformed_percent) {
+                    oss << malformed[which(rng)] << '\n';
+                }
+                else {
+                    oss << dist(rng) << '\n';
+                }
+            }
+            return oss.str();
+        });
+}
+
 template <typename Int>
 std::vector<std::string> stringified_integers_list(size_t n = INT_DATA_N)
 {
-    static std::uniform_int_distribution<Int> dist(
-        std::numeric_limits<Int>::min(), std::numeric_limits<Int>::max());
-    std::vector<std::string> ret;
-    for (size_t i = 0; i < n; ++i) {
-        std::ostringstream oss;
-        oss << dist(get_rng());
-        ret.push_back(std::move(oss).str());
-    }
-    return ret;
+    return split_corpus_lines(integer_corpus<Int>(n));
 }
 
 template <typename Int>
 std::string stringified_integer_list(size_t n = INT_DATA_N,
                                      const char* delim = " ")
 {
-    static std::uniform_int_distribution<Int> dist(
-        std::numeric_limits<Int>::min(), std::numeric_limits<Int>::max());
-
-    std::ostringstream oss;
-    for (size_t i = 0; i < n; ++i) {
-        oss << dist(get_rng()) << delim;
-    }
-    return oss.str();
+    return join_corpus_lines(integer_corpus<Int>(n), delim);
 }
 
 inline int scanf_integral(const char* ptr, int& i)
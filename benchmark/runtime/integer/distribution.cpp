@@ -0,0 +1,132 @@
+// Copyright 2017 Elias Kosunen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// This file is a part of scnlib:
+//     https://github.com/eliaskosunen/scnlib
+
+#include "bench_int.h"
+
+// Integers with uniformly distributed digit counts exercise every length
+// the parser handles, instead of mostly the longest ones
+
+template <typename Int>
+static void scan_int_uniform_length_scn(benchmark::State& state)
+{
+    auto data = uniform_length_integer_corpus<Int>();
+    Int i{};
+    auto result = scn::make_result(data);
+    for (auto _ : state) {
+        result = scn::scan_default(result.range(), i);
+
+        if (!result) {
+            if (result.error() == scn::error::end_of_range) {
+                result = scn::make_result(data);
+            }
+            else {
+                state.SkipWithError("Benchmark errored");
+                break;
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(scan_int_uniform_length_scn, int);
+BENCHMARK_TEMPLATE(scan_int_uniform_length_scn, long long);
+BENCHMARK_TEMPLATE(scan_int_uniform_length_scn, unsigned);
+
+template <typename Int>
+static void scan_int_uniform_length_sstream(benchmark::State& state)
+{
+    auto data = uniform_length_integer_corpus<Int>();
+    auto stream = std::istringstream(data);
+    Int i{};
+    for (auto _ : state) {
+        stream >> i;
+
+        if (stream.eof()) {
+            stream = std::istringstream(data);
+        }
+        else if (stream.fail()) {
+            state.SkipWithError("Benchmark errored");
+            break;
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(scan_int_uniform_length_sstream, int);
+BENCHMARK_TEMPLATE(scan_int_uniform_length_sstream, long long);
+BENCHMARK_TEMPLATE(scan_int_uniform_length_sstream, unsigned);
+
+// Malformed tokens are skipped, like an application recovering from bad
+// input would
+
+template <typename Int>
+static void scan_int_malformed_scn(benchmark::State& state)
+{
+    auto data = malformed_integer_corpus<Int>(INT_DATA_N,
+                                              static_cast<int>(state.range(0)));
+    Int i{};
+    auto result = scn::make_result(data);
+    for (auto _ : state) {
+        result = scn::scan_default(result.range(), i);
+
+        if (!result) {
+            if (result.error() == scn::error::end_of_range) {
+                result = scn::make_result(data);
+            }
+            else if (result.error() == scn::error::invalid_scanned_value ||
+                     result.error() == scn::error::value_out_of_range) {
+                scn::string_view token{};
+                result = scn::scan_default(result.range(), token);
+            }
+            else {
+                state.SkipWithError("Benchmark errored");
+                break;
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(scan_int_malformed_scn, int)
+    ->ArgName("malformed_percent")
+    ->Arg(0)
+    ->Arg(10)
+    ->Arg(50);
+
+template <typename Int>
+static void scan_int_malformed_sstream(benchmark::State& state)
+{
+    auto data = malformed_integer_corpus<Int>(INT_DATA_N,
+                                              static_cast<int>(state.range(0)));
+    auto stream = std::istringstream(data);
+    Int i{};
+    std::string token;
+    for (auto _ : state) {
+        stream >> i;
+
+        if (stream.eof()) {
+            stream = std::istringstream(data);
+        }
+        else if (stream.fail()) {
+            stream.clear();
+            stream >> token;
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(scan_int_malformed_sstream, int)
+    ->ArgName("malformed_percent")
+    ->Arg(0)
+    ->Arg(10)
+    ->Arg(50);
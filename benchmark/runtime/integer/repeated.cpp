@@ -69,6 +69,32 @@ BENCHMARK_TEMPLATE(scan_int_repeated_scn_default, int);
 BENCHMARK_TEMPLATE(scan_int_repeated_scn_default, long long);
 BENCHMARK_TEMPLATE(scan_int_repeated_scn_default, unsigned);
 
+template <typename Int>
+static void scan_int_repeated_scn_direct(benchmark::State& state)
+{
+    auto data = stringified_integer_list<Int>();
+    Int i{};
+    auto result = scn::make_result(data);
+    for (auto _ : state) {
+        result = scn::scan_direct(result.range(), i);
+
+        if (!result) {
+            if (result.error() == scn::error::end_of_range) {
+                result = scn::make_result(data);
+            }
+            else {
+                state.SkipWithError("Benchmark errored");
+                break;
+            }
+        }
+    }
+    state.SetBytesProcessed(
+        state.iterations() * static_cast<int64_t>(sizeof(Int)));
+}
+BENCHMARK_TEMPLATE(scan_int_repeated_scn_direct, int);
+BENCHMARK_TEMPLATE(scan_int_repeated_scn_direct, long long);
+BENCHMARK_TEMPLATE(scan_int_repeated_scn_direct, unsigned);
+
 template <typename Int>
 static void scan_int_repeated_scn_value(benchmark::State& state)
 {
@@ -0,0 +1,234 @@
+// Copyright 2017 Elias Kosunen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// This file is a part of scnlib:
+//     https://github.com/eliaskosunen/scnlib
+
+#ifndef SCN_BENCHMARK_LATENCY_H
+#define SCN_BENCHMARK_LATENCY_H
+
+#include "../sources.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || \
+    defined(_M_IX86)
+#define SCN_BENCHMARK_HAS_RDTSC 1
+#if SCN_MSVC
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#else
+#define SCN_BENCHMARK_HAS_RDTSC 0
+#endif
+
+// Timestamps for timing a single call.
+// Uses the TSC where available, as it's cheaper and finer-grained than
+// std::chrono::steady_clock, and steady_clock (in nanoseconds) elsewhere.
+struct latency_clock {
+    static std::uint64_t now() noexcept
+    {
+#if SCN_BENCHMARK_HAS_RDTSC
+        // Keep the call being timed from being reordered around rdtsc
+        _mm_lfence();
+        const auto t = __rdtsc();
+        _mm_lfence();
+        return t;
+#else
+        return static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch())
+                .count());
+#endif
+    }
+
+    // Measured once, against steady_clock
+    static double ns_per_tick()
+    {
+        static const double value = calibrate();
+        return value;
+    }
+
+    // The smallest difference between two back-to-back calls to now(),
+    // subtracted from every sample
+    static std::uint64_t overhead()
+    {
+        static const std::uint64_t value = [] {
+            auto min = std::numeric_limits<std::uint64_t>::max();
+            for (int i = 0; i < 1000; ++i) {
+                const auto begin = now();
+                const auto end = now();
+                min = std::min(min, end - begin);
+            }
+            return min;
+        }();
+        return value;
+    }
+
+private:
+    static double calibrate()
+    {
+#if SCN_BENCHMARK_HAS_RDTSC
+        using clock = std::chrono::steady_clock;
+        const auto clock_begin = clock::now();
+        const auto tsc_begin = now();
+        while (clock::now() - clock_begin < std::chrono::milliseconds(20)) {
+        }
+        const auto tsc_end = now();
+        const auto clock_end = clock::now();
+        const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            clock_end - clock_begin)
+                            .count();
+        return static_cast<double>(ns) /
+               static_cast<double>(tsc_end - tsc_begin);
+#else
+        return 1.0;
+#endif
+    }
+};
+
+// A histogram with log-linear buckets, like HdrHistogram:
+// values below 2^(sub_bucket_bits + 1) are recorded exactly, and larger
+// values with a relative error of at most 2^-sub_bucket_bits (~3%).
+// Recording is constant-time and doesn't allocate.
+class latency_histogram {
+public:
+    static constexpr unsigned sub_bucket_bits = 5;
+    static constexpr std::uint64_t sub_bucket_count = std::uint64_t{1}
+                                                      << sub_bucket_bits;
+    static constexpr size_t bucket_count =
+        (64 - sub_bucket_bits + 1) * sub_bucket_count;
+
+    latency_histogram() : m_counts(bucket_count, 0) {}
+
+    void record(std::uint64_t value)
+    {
+        ++m_counts[index_of(value)];
+        ++m_total;
+        m_max = std::max(m_max, value);
+    }
+
+    std::uint64_t count() const
+    {
+        return m_total;
+    }
+    std::uint64_t max() const
+    {
+        return m_max;
+    }
+
+    // The smallest recorded value that `percentile` percent of the
+    // recorded values are less than or equal to, rounded up to the upper
+    // bound of its bucket
+    std::uint64_t percentile(double percentile) const
+    {
+        if (m_total == 0) {
+            return 0;
+        }
+        const auto target = static_cast<std::uint64_t>(std::ceil(
+            percentile / 100.0 * static_cast<double>(m_total)));
+        std::uint64_t seen = 0;
+        for (size_t i = 0; i < m_counts.size(); ++i) {
+            seen += m_counts[i];
+            if (seen >= std::max(target, std::uint64_t{1})) {
+                return std::min(upper_bound_of(i), m_max);
+            }
+        }
+        return m_max;
+    }
+
+private:
+    static unsigned highest_bit(std::uint64_t value)
+    {
+        unsigned bit = 0;
+        while (value >>= 1) {
+            ++bit;
+        }
+        return bit;
+    }
+
+    static size_t index_of(std::uint64_t value)
+    {
+        if (value < 2 * sub_bucket_count) {
+            return static_cast<size_t>(value);
+        }
+        const auto shift = highest_bit(value) - sub_bucket_bits;
+        return static_cast<size_t>(shift * sub_bucket_count +
+                                   (value >> shift));
+    }
+    static std::uint64_t upper_bound_of(size_t index)
+    {
+        if (index < 2 * sub_bucket_count) {
+            return index;
+        }
+        const auto shift = index / sub_bucket_count - 1;
+        const auto top = index % sub_bucket_count + sub_bucket_count;
+        return ((top + 1) << shift) - 1;
+    }
+
+    std::vector<std::uint64_t> m_counts;
+    std::uint64_t m_total{0};
+    std::uint64_t m_max{0};
+};
+
+// Calls `scanner(result)` once per iteration, timing every call
+// individually, and reports the latency percentiles in nanoseconds.
+// Reaching the end of the source resets it, outside of the timed region.
+template <typename Source, typename Scanner>
+void run_latency_benchmark(benchmark::State& state)
+{
+    Source source{Scanner::data()};
+    Scanner scanner{};
+    latency_histogram histogram{};
+    const auto overhead = latency_clock::overhead();
+
+    auto result = scn::make_result(source.range());
+    for (auto _ : state) {
+        const auto begin = latency_clock::now();
+        const auto e = scanner(result);
+        const auto end = latency_clock::now();
+
+        if (!e) {
+            if (e.code() == scn::error::end_of_range) {
+                state.PauseTiming();
+                source.reset();
+                result = scn::make_result(source.range());
+                state.ResumeTiming();
+                continue;
+            }
+            state.SkipWithError("Benchmark errored");
+            break;
+        }
+        const auto elapsed = end - begin;
+        histogram.record(elapsed > overhead ? elapsed - overhead : 0);
+    }
+
+    const auto to_ns = [](std::uint64_t ticks) {
+        return static_cast<double>(ticks) * latency_clock::ns_per_tick();
+    };
+    state.counters["p50_ns"] = to_ns(histogram.percentile(50.0));
+    state.counters["p90_ns"] = to_ns(histogram.percentile(90.0));
+    state.counters["p99_ns"] = to_ns(histogram.percentile(99.0));
+    state.counters["p999_ns"] = to_ns(histogram.percentile(99.9));
+    state.counters["max_ns"] = to_ns(histogram.max());
+    state.SetItemsProcessed(static_cast<int64_t>(histogram.count()));
+}
+
+#endif  // SCN_BENCHMARK_LATENCY_H
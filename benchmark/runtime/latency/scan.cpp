@@ -0,0 +1,148 @@
+// Copyright 2017 Elias Kosunen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// This file is a part of scnlib:
+//     https://github.com/eliaskosunen/scnlib
+
+#include "bench_latency.h"
+
+#include "../float/bench_float.h"
+#include "../integer/bench_int.h"
+#include "../other/bench_other.h"
+#include "../word/bench_word.h"
+
+#define LATENCY_DATA_N (static_cast<size_t>(2 << 12))
+
+struct int_scanner {
+    static std::string data()
+    {
+        return integer_corpus<int>(LATENCY_DATA_N);
+    }
+
+    template <typename Result>
+    scn::error operator()(Result& result)
+    {
+        result = scn::scan_default(result.range(), value);
+        benchmark::DoNotOptimize(value);
+        return result.error();
+    }
+
+    int value{};
+};
+
+template <typename Source>
+static void latency_int(benchmark::State& state)
+{
+    run_latency_benchmark<Source, int_scanner>(state);
+}
+BENCHMARK_ALL_SOURCES(latency_int);
+
+struct double_scanner {
+    static std::string data()
+    {
+        return wide_exponent_float_corpus<double>(LATENCY_DATA_N);
+    }
+
+    template <typename Result>
+    scn::error operator()(Result& result)
+    {
+        result = scn::scan_default(result.range(), value);
+        benchmark::DoNotOptimize(value);
+        return result.error();
+    }
+
+    double value{};
+};
+
+template <typename Source>
+static void latency_double(benchmark::State& state)
+{
+    run_latency_benchmark<Source, double_scanner>(state);
+}
+BENCHMARK_ALL_SOURCES(latency_double);
+
+struct word_scanner {
+    static std::string data()
+    {
+        return skewed_word_corpus(LATENCY_DATA_N);
+    }
+
+    template <typename Result>
+    scn::error operator()(Result& result)
+    {
+        result = scn::scan_default(result.range(), value);
+        benchmark::DoNotOptimize(value.data());
+        return result.error();
+    }
+
+    std::string value{};
+};
+
+template <typename Source>
+static void latency_word(benchmark::State& state)
+{
+    run_latency_benchmark<Source, word_scanner>(state);
+}
+BENCHMARK_ALL_SOURCES(latency_word);
+
+struct getline_scanner {
+    static std::string data()
+    {
+        return log_lines_corpus(LATENCY_DATA_N);
+    }
+
+    template <typename Result>
+    scn::error operator()(Result& result)
+    {
+        result = scn::getline(result.range(), value);
+        benchmark::DoNotOptimize(value.data());
+        return result.error();
+    }
+
+    std::string value{};
+};
+
+template <typename Source>
+static void latency_getline(benchmark::State& state)
+{
+    run_latency_benchmark<Source, getline_scanner>(state);
+}
+BENCHMARK_ALL_SOURCES(latency_getline);
+
+#if !SCN_USE_STATIC_LOCALE
+struct localized_int_scanner {
+    static std::string data()
+    {
+        return integer_corpus<int>(LATENCY_DATA_N);
+    }
+
+    template <typename Result>
+    scn::error operator()(Result& result)
+    {
+        result = scn::scan_localized(std::locale::classic(), result.range(),
+                                     "{:L}", value);
+        benchmark::DoNotOptimize(value);
+        return result.error();
+    }
+
+    int value{};
+};
+
+template <typename Source>
+static void latency_localized_int(benchmark::State& state)
+{
+    run_latency_benchmark<Source, localized_int_scanner>(state);
+}
+BENCHMARK_TEMPLATE(latency_localized_int, string_view_source);
+#endif
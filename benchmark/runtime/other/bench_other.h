@@ -0,0 +1,190 @@
+// Copyright 2017 Elias Kosunen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// This file is a part of scnlib:
+//     https://github.com/eliaskosunen/scnlib
+
+#ifndef SCN_BENCHMARK_OTHER_H
+#define SCN_BENCHMARK_OTHER_H
+
+#include "../benchmark.h"
+
+#include <cstdio>
+#include <limits>
+#include <sstream>
+#include <string>
+
+#define OTHER_DATA_N (static_cast<size_t>(2 << 12))
+
+// Selects the narrow or the wide version of a string literal
+template <typename CharT>
+struct literal_selector;
+template <>
+struct literal_selector<char> {
+    static constexpr const char* select(const char* s, const wchar_t*)
+    {
+        return s;
+    }
+};
+template <>
+struct literal_selector<wchar_t> {
+    static constexpr const wchar_t* select(const char*, const wchar_t* s)
+    {
+        return s;
+    }
+};
+#define BENCH_LITERAL(CharT, str) literal_selector<CharT>::select(str, L##str)
+
+template <typename CharT>
+std::basic_string<CharT> widen_ascii(const std::string& s)
+{
+    return {s.begin(), s.end()};
+}
+
+// `n` lines of `words_per_line` lowercase words
+template <typename CharT>
+std::basic_string<CharT> lines_list(size_t n = OTHER_DATA_N,
+                                    size_t words_per_line = 4)
+{
+    std::uniform_int_distribution<int> letter('a', 'z');
+    std::uniform_int_distribution<int> length(1, 12);
+    auto rng = make_rng();
+
+    std::string ret;
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j < words_per_line; ++j) {
+            if (j != 0) {
+                ret.push_back(' ');
+            }
+            const auto len = length(rng);
+            for (int k = 0; k < len; ++k) {
+                ret.push_back(static_cast<char>(letter(rng)));
+            }
+        }
+        ret.push_back('\n');
+    }
+    return widen_ascii<CharT>(ret);
+}
+
+// `n` access log lines, like
+// "2021-03-14 09:26:53.589 INFO [worker-3] GET /api/v1/items/7932 200 12.38"
+// with a skewed mix of log levels, methods and status codes
+inline std::string generate_log_lines(std::mt19937_64& rng, size_t n)
+{
+    static const char* const levels[] = {"INFO", "WARN", "ERROR", "DEBUG"};
+    static const char* const methods[] = {"GET", "POST", "PUT", "DELETE"};
+    static const char* const paths[] = {"/api/v1/items/", "/api/v1/users/",
+                                        "/static/img/", "/health/"};
+    static const int statuses[] = {200, 201, 204, 304, 400, 404, 500};
+    std::discrete_distribution<int> level{80, 12, 5, 3};
+    std::discrete_distribution<int> method{70, 20, 7, 3};
+    std::uniform_int_distribution<int> path(0, 3);
+    std::discrete_distribution<int> status{75, 5, 3, 8, 3, 5, 1};
+    std::uniform_int_distribution<int> id(0, 99999);
+    std::uniform_int_distribution<int> worker(0, 15);
+    std::exponential_distribution<double> latency(1.0 / 20.0);
+
+    long long millis = 1615713600000LL;  // 2021-03-14 09:20:00
+    std::uniform_int_distribution<int> step(0, 250);
+
+    std::string ret;
+    char buf[160];
+    for (size_t i = 0; i < n; ++i) {
+        millis += step(rng);
+        const auto secs = static_cast<int>((millis / 1000) % 86400);
+        std::snprintf(buf, sizeof(buf),
+                      "2021-03-14 %02d:%02d:%02d.%03d %s [worker-%d] %s "
+                      "%s%d %d %.2f\n",
+                      secs / 3600, (secs / 60) % 60, secs % 60,
+                      static_cast<int>(millis % 1000), levels[level(rng)],
+                      worker(rng), methods[method(rng)], paths[path(rng)],
+                      id(rng), statuses[status(rng)], latency(rng));
+        ret += buf;
+    }
+    return ret;
+}
+
+inline std::string log_lines_corpus(size_t n)
+{
+    return load_corpus(
+        "log-lines-" + std::to_string(n),
+        [n](std::mt19937_64& rng) { return generate_log_lines(rng, n); });
+}
+
+template <typename CharT>
+std::basic_string<CharT> log_lines_list(size_t n = OTHER_DATA_N)
+{
+    return widen_ascii<CharT>(log_lines_corpus(n));
+}
+
+// `n` integers, separated by `sep`
+template <typename CharT>
+std::basic_string<CharT> separated_int_list(size_t n = OTHER_DATA_N,
+                                            const char* sep = " ")
+{
+    std::uniform_int_distribution<int> dist(std::numeric_limits<int>::min(),
+                                            std::numeric_limits<int>::max());
+    auto rng = make_rng();
+
+    std::string ret;
+    for (size_t i = 0; i < n; ++i) {
+        if (i != 0) {
+            ret += sep;
+        }
+        ret += std::to_string(dist(rng));
+    }
+    return widen_ascii<CharT>(ret);
+}
+
+// `n` booleans, alternating between the textual and numeric forms
+template <typename CharT>
+std::basic_string<CharT> bool_list(size_t n = OTHER_DATA_N)
+{
+    std::bernoulli_distribution dist{};
+    auto rng = make_rng();
+    static const char* const values[] = {"false", "true", "0", "1"};
+
+    std::string ret;
+    for (size_t i = 0; i < n; ++i) {
+        ret += values[(i % 2) * 2 + (dist(rng) ? 1 : 0)];
+        ret.push_back(' ');
+    }
+    return widen_ascii<CharT>(ret);
+}
+
+// Repeatedly scans a value from `data` with `scan`, starting over after
+// reaching the end
+template <typename CharT, typename Scan>
+void run_repeated(benchmark::State& state,
+                  const std::basic_string<CharT>& data,
+                  Scan scan)
+{
+    auto result = scn::make_result(data);
+    for (auto _ : state) {
+        result = scan(result.range());
+
+        if (!result) {
+            if (result.error() == scn::error::end_of_range) {
+                result = scn::make_result(data);
+            }
+            else {
+                state.SkipWithError("Benchmark errored");
+                break;
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+#endif  // SCN_BENCHMARK_OTHER_H
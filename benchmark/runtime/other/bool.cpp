@@ -0,0 +1,66 @@
+// Copyright 2017 Elias Kosunen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// This file is a part of scnlib:
+//     https://github.com/eliaskosunen/scnlib
+
+#include "bench_other.h"
+
+template <typename Char>
+static void scan_bool_scn(benchmark::State& state)
+{
+    auto data = bool_list<Char>();
+    bool b{};
+    run_repeated(state, data, [&](auto& range) {
+        return scn::scan(range, BENCH_LITERAL(Char, "{}"), b);
+    });
+}
+BENCHMARK_TEMPLATE(scan_bool_scn, char);
+BENCHMARK_TEMPLATE(scan_bool_scn, wchar_t);
+
+template <typename Char>
+static void scan_bool_scn_default(benchmark::State& state)
+{
+    auto data = bool_list<Char>();
+    bool b{};
+    run_repeated(state, data,
+                 [&](auto& range) { return scn::scan_default(range, b); });
+}
+BENCHMARK_TEMPLATE(scan_bool_scn_default, char);
+BENCHMARK_TEMPLATE(scan_bool_scn_default, wchar_t);
+
+template <typename Char>
+static void scan_code_point_scn(benchmark::State& state)
+{
+    auto data = lines_list<Char>();
+    scn::code_point cp{};
+    run_repeated(state, data, [&](auto& range) {
+        return scn::scan(range, BENCH_LITERAL(Char, "{}"), cp);
+    });
+}
+BENCHMARK_TEMPLATE(scan_code_point_scn, char);
+BENCHMARK_TEMPLATE(scan_code_point_scn, wchar_t);
+
+// Same data, read as code units, for comparison
+template <typename Char>
+static void scan_code_point_scn_char(benchmark::State& state)
+{
+    auto data = lines_list<Char>();
+    Char ch{};
+    run_repeated(state, data, [&](auto& range) {
+        return scn::scan(range, BENCH_LITERAL(Char, "{}"), ch);
+    });
+}
+BENCHMARK_TEMPLATE(scan_code_point_scn_char, char);
+BENCHMARK_TEMPLATE(scan_code_point_scn_char, wchar_t);
@@ -0,0 +1,62 @@
+// Copyright 2017 Elias Kosunen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// This file is a part of scnlib:
+//     https://github.com/eliaskosunen/scnlib
+
+#include "bench_other.h"
+
+template <typename Char>
+static void getline_scn(benchmark::State& state)
+{
+    auto data = lines_list<Char>();
+    std::basic_string<Char> line{};
+    run_repeated(state, data,
+                 [&](auto& range) { return scn::getline(range, line); });
+}
+BENCHMARK_TEMPLATE(getline_scn, char);
+BENCHMARK_TEMPLATE(getline_scn, wchar_t);
+
+template <typename Char>
+static void getline_scn_view(benchmark::State& state)
+{
+    auto data = lines_list<Char>();
+    scn::basic_string_view<Char> line{};
+    run_repeated(state, data,
+                 [&](auto& range) { return scn::getline(range, line); });
+}
+BENCHMARK_TEMPLATE(getline_scn_view, char);
+BENCHMARK_TEMPLATE(getline_scn_view, wchar_t);
+
+template <typename Char>
+static void getline_std(benchmark::State& state)
+{
+    auto data = lines_list<Char>();
+    auto stream = std::basic_istringstream<Char>(data);
+    std::basic_string<Char> line{};
+    for (auto _ : state) {
+        std::getline(stream, line);
+
+        if (stream.eof()) {
+            stream = std::basic_istringstream<Char>(data);
+        }
+        else if (stream.fail()) {
+            state.SkipWithError("Benchmark errored");
+            break;
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(getline_std, char);
+BENCHMARK_TEMPLATE(getline_std, wchar_t);
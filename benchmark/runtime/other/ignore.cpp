@@ -0,0 +1,59 @@
+// Copyright 2017 Elias Kosunen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// This file is a part of scnlib:
+//     https://github.com/eliaskosunen/scnlib
+
+#include "bench_other.h"
+
+template <typename Char>
+static void ignore_until_scn(benchmark::State& state)
+{
+    auto data = lines_list<Char>();
+    const auto until = scn::detail::ascii_widen<Char>('\n');
+    run_repeated(state, data, [&](auto& range) {
+        // ignore_until stops at `until`, advance past it like
+        // std::istream::ignore does
+        auto result = scn::ignore_until(range, until);
+        if (!result) {
+            return result;
+        }
+        return scn::ignore_until_n(result.range(), 1, Char{0});
+    });
+}
+BENCHMARK_TEMPLATE(ignore_until_scn, char);
+BENCHMARK_TEMPLATE(ignore_until_scn, wchar_t);
+
+template <typename Char>
+static void ignore_until_std(benchmark::State& state)
+{
+    auto data = lines_list<Char>();
+    auto stream = std::basic_istringstream<Char>(data);
+    const auto until = scn::detail::ascii_widen<Char>('\n');
+    for (auto _ : state) {
+        stream.ignore(std::numeric_limits<std::streamsize>::max(),
+                      std::char_traits<Char>::to_int_type(until));
+
+        if (stream.eof()) {
+            stream = std::basic_istringstream<Char>(data);
+        }
+        else if (stream.fail()) {
+            state.SkipWithError("Benchmark errored");
+            break;
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(ignore_until_std, char);
+BENCHMARK_TEMPLATE(ignore_until_std, wchar_t);
@@ -0,0 +1,108 @@
+// Copyright 2017 Elias Kosunen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// This file is a part of scnlib:
+//     https://github.com/eliaskosunen/scnlib
+
+#include "bench_other.h"
+
+#include <vector>
+
+template <typename Char>
+static void scan_list_scn(benchmark::State& state)
+{
+    const auto n = static_cast<size_t>(state.range(0));
+    auto data = separated_int_list<Char>(n);
+    std::vector<int> read;
+    read.reserve(n);
+
+    for (auto _ : state) {
+        read.clear();
+        auto result = scn::scan_list(data, read);
+
+        if (!result) {
+            state.SkipWithError("Benchmark errored");
+            break;
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) *
+                            state.range(0));
+}
+BENCHMARK_TEMPLATE(scan_list_scn, char)->Arg(16)->Arg(64)->Arg(256);
+BENCHMARK_TEMPLATE(scan_list_scn, wchar_t)->Arg(16)->Arg(64)->Arg(256);
+
+template <typename Char>
+static void scan_list_scn_separator(benchmark::State& state)
+{
+    const auto n = static_cast<size_t>(state.range(0));
+    auto data = separated_int_list<Char>(n, ", ");
+    std::vector<int> read;
+    read.reserve(n);
+    const auto options =
+        scn::list_separator(scn::detail::ascii_widen<Char>(','));
+
+    for (auto _ : state) {
+        read.clear();
+        auto result = scn::scan_list_ex(data, read, options);
+
+        if (!result) {
+            state.SkipWithError("Benchmark errored");
+            break;
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) *
+                            state.range(0));
+}
+BENCHMARK_TEMPLATE(scan_list_scn_separator, char)->Arg(16)->Arg(64)->Arg(256);
+BENCHMARK_TEMPLATE(scan_list_scn_separator, wchar_t)
+    ->Arg(16)
+    ->Arg(64)
+    ->Arg(256);
+
+template <typename Char>
+static void scan_list_sstream_separator(benchmark::State& state)
+{
+    const auto n = static_cast<size_t>(state.range(0));
+    auto data = separated_int_list<Char>(n, ", ");
+    std::vector<int> read;
+    read.reserve(n);
+
+    for (auto _ : state) {
+        read.clear();
+        std::basic_istringstream<Char> stream{data};
+        int i{};
+        Char sep{};
+        while (stream >> i) {
+            read.push_back(i);
+            if (!(stream >> sep)) {
+                break;
+            }
+        }
+
+        if (!stream.eof()) {
+            state.SkipWithError("Benchmark errored");
+            break;
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) *
+                            state.range(0));
+}
+BENCHMARK_TEMPLATE(scan_list_sstream_separator, char)
+    ->Arg(16)
+    ->Arg(64)
+    ->Arg(256);
+BENCHMARK_TEMPLATE(scan_list_sstream_separator, wchar_t)
+    ->Arg(16)
+    ->Arg(64)
+    ->Arg(256);
@@ -0,0 +1,77 @@
+// Copyright 2017 Elias Kosunen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// This file is a part of scnlib:
+//     https://github.com/eliaskosunen/scnlib
+
+#include "bench_other.h"
+
+#include <locale>
+
+// scan_localized isn't available with SCN_USE_STATIC_LOCALE
+#if !SCN_USE_STATIC_LOCALE
+
+template <typename Char>
+static void scan_localized_scn(benchmark::State& state)
+{
+    auto data = separated_int_list<Char>();
+    const auto loc = std::locale{};
+    int i{};
+    run_repeated(state, data, [&](auto& range) {
+        return scn::scan_localized(loc, range, BENCH_LITERAL(Char, "{:L}"),
+                                   i);
+    });
+}
+BENCHMARK_TEMPLATE(scan_localized_scn, char);
+BENCHMARK_TEMPLATE(scan_localized_scn, wchar_t);
+
+// Localized API, without the 'L' flag
+template <typename Char>
+static void scan_localized_scn_classic(benchmark::State& state)
+{
+    auto data = separated_int_list<Char>();
+    const auto loc = std::locale{};
+    int i{};
+    run_repeated(state, data, [&](auto& range) {
+        return scn::scan_localized(loc, range, BENCH_LITERAL(Char, "{}"), i);
+    });
+}
+BENCHMARK_TEMPLATE(scan_localized_scn_classic, char);
+BENCHMARK_TEMPLATE(scan_localized_scn_classic, wchar_t);
+
+#endif  // !SCN_USE_STATIC_LOCALE
+
+template <typename Char>
+static void scan_localized_sstream(benchmark::State& state)
+{
+    auto data = separated_int_list<Char>();
+    auto stream = std::basic_istringstream<Char>(data);
+    stream.imbue(std::locale{});
+    int i{};
+    for (auto _ : state) {
+        stream >> i;
+
+        if (stream.eof()) {
+            stream = std::basic_istringstream<Char>(data);
+            stream.imbue(std::locale{});
+        }
+        else if (stream.fail()) {
+            state.SkipWithError("Benchmark errored");
+            break;
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(scan_localized_sstream, char);
+BENCHMARK_TEMPLATE(scan_localized_sstream, wchar_t);
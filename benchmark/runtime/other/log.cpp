@@ -0,0 +1,72 @@
+// Copyright 2017 Elias Kosunen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// This file is a part of scnlib:
+//     https://github.com/eliaskosunen/scnlib
+
+#include "bench_other.h"
+
+template <typename Char>
+static void getline_log_scn(benchmark::State& state)
+{
+    auto data = log_lines_list<Char>();
+    scn::basic_string_view<Char> line{};
+    run_repeated(state, data,
+                 [&](auto& range) { return scn::getline(range, line); });
+}
+BENCHMARK_TEMPLATE(getline_log_scn, char);
+BENCHMARK_TEMPLATE(getline_log_scn, wchar_t);
+
+template <typename Char>
+static void parse_log_scn(benchmark::State& state)
+{
+    using string_view_type = scn::basic_string_view<Char>;
+    auto data = log_lines_list<Char>();
+    string_view_type date{}, time{}, level{}, method{}, path{};
+    int worker{}, status{};
+    double latency{};
+    run_repeated(state, data, [&](auto& range) {
+        return scn::scan(
+            range, BENCH_LITERAL(Char, "{} {} {} [worker-{}] {} {} {} {}"),
+            date, time, level, worker, method, path, status, latency);
+    });
+}
+BENCHMARK_TEMPLATE(parse_log_scn, char);
+BENCHMARK_TEMPLATE(parse_log_scn, wchar_t);
+
+template <typename Char>
+static void parse_log_sstream(benchmark::State& state)
+{
+    using string_type = std::basic_string<Char>;
+    auto data = log_lines_list<Char>();
+    auto stream = std::basic_istringstream<Char>(data);
+    string_type date{}, time{}, level{}, worker{}, method{}, path{};
+    int status{};
+    double latency{};
+    for (auto _ : state) {
+        stream >> date >> time >> level >> worker >> method >> path >>
+            status >> latency;
+
+        if (stream.eof()) {
+            stream = std::basic_istringstream<Char>(data);
+        }
+        else if (stream.fail()) {
+            state.SkipWithError("Benchmark errored");
+            break;
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(parse_log_sstream, char);
+BENCHMARK_TEMPLATE(parse_log_sstream, wchar_t);
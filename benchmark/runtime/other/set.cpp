@@ -0,0 +1,55 @@
+// Copyright 2017 Elias Kosunen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// This file is a part of scnlib:
+//     https://github.com/eliaskosunen/scnlib
+
+#include "bench_other.h"
+
+template <typename Char>
+static void scan_set_scn(benchmark::State& state)
+{
+    auto data = lines_list<Char>();
+    std::basic_string<Char> str{};
+    run_repeated(state, data, [&](auto& range) {
+        return scn::scan(range, BENCH_LITERAL(Char, " {:[a-z]}"), str);
+    });
+}
+BENCHMARK_TEMPLATE(scan_set_scn, char);
+BENCHMARK_TEMPLATE(scan_set_scn, wchar_t);
+
+template <typename Char>
+static void scan_set_scn_view(benchmark::State& state)
+{
+    auto data = lines_list<Char>();
+    scn::basic_string_view<Char> str{};
+    run_repeated(state, data, [&](auto& range) {
+        return scn::scan(range, BENCH_LITERAL(Char, " {:[a-z]}"), str);
+    });
+}
+BENCHMARK_TEMPLATE(scan_set_scn_view, char);
+BENCHMARK_TEMPLATE(scan_set_scn_view, wchar_t);
+
+// Same data, without a [set], for comparison
+template <typename Char>
+static void scan_set_scn_word(benchmark::State& state)
+{
+    auto data = lines_list<Char>();
+    std::basic_string<Char> str{};
+    run_repeated(state, data, [&](auto& range) {
+        return scn::scan(range, BENCH_LITERAL(Char, "{}"), str);
+    });
+}
+BENCHMARK_TEMPLATE(scan_set_scn_word, char);
+BENCHMARK_TEMPLATE(scan_set_scn_word, wchar_t);
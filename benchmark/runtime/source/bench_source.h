@@ -0,0 +1,220 @@
+// Copyright 2017 Elias Kosunen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// This file is a part of scnlib:
+//     https://github.com/eliaskosunen/scnlib
+
+#ifndef SCN_BENCHMARK_SOURCE_H
+#define SCN_BENCHMARK_SOURCE_H
+
+#include "../benchmark.h"
+
+#include <scn/istream.h>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#if SCN_POSIX
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+// A corpus written to a file, removed on destruction.
+// The data is flushed to disk, so that it can be evicted from the page cache.
+class temp_file {
+public:
+    temp_file(std::string path, const std::string& data)
+        : m_path(std::move(path)), m_size(data.size())
+    {
+        auto f = std::fopen(m_path.c_str(), "wb");
+        std::fwrite(data.data(), 1, data.size(), f);
+        std::fflush(f);
+#if SCN_POSIX
+        ::fsync(::fileno(f));
+#endif
+        std::fclose(f);
+    }
+    temp_file(const temp_file&) = delete;
+    temp_file& operator=(const temp_file&) = delete;
+    ~temp_file()
+    {
+        std::remove(m_path.c_str());
+    }
+
+    const char* path() const
+    {
+        return m_path.c_str();
+    }
+    size_t size() const
+    {
+        return m_size;
+    }
+
+private:
+    std::string m_path;
+    size_t m_size;
+};
+
+// Evicts the file from the page cache, returns false if not supported
+inline bool drop_page_cache(const temp_file& file)
+{
+#if SCN_POSIX && defined(POSIX_FADV_DONTNEED)
+    const int fd = ::open(file.path(), O_RDONLY);
+    if (fd == -1) {
+        return false;
+    }
+    const int ret = ::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+    ::close(fd);
+    return ret == 0;
+#else
+    SCN_UNUSED(file);
+    return false;
+#endif
+}
+
+inline void warm_page_cache(const temp_file& file)
+{
+    auto f = std::fopen(file.path(), "rb");
+    std::vector<char> buf(file.size());
+    benchmark::DoNotOptimize(std::fread(buf.data(), 1, buf.size(), f));
+    std::fclose(f);
+}
+
+// Source scanners: each one opens `path`, reads every value in it,
+// and returns `false` on error
+
+template <typename T, typename Range>
+bool scan_all(Range&& range, size_t& values)
+{
+    auto result = scn::make_result(SCN_FWD(range));
+    T val{};
+    while (true) {
+        result = scn::scan_default(result.range(), val);
+        if (!result) {
+            return result.error() == scn::error::end_of_range;
+        }
+        benchmark::DoNotOptimize(val);
+        ++values;
+    }
+}
+
+template <typename T>
+bool scan_owning_file(const char* path, size_t& values)
+{
+    scn::owning_file file{path, "r"};
+    return scan_all<T>(file, values);
+}
+
+template <typename T>
+bool scan_file(const char* path, size_t& values)
+{
+    auto f = std::fopen(path, "r");
+    bool ret{};
+    {
+        scn::file file{f};
+        ret = scan_all<T>(file, values);
+    }
+    std::fclose(f);
+    return ret;
+}
+
+template <typename T>
+bool scan_cstdin(const char* path, size_t& values)
+{
+    if (!std::freopen(path, "r", stdin)) {
+        return false;
+    }
+    auto ret = scan_all<T>(scn::cstdin(), values);
+    scn::cstdin().sync();
+    return ret;
+}
+
+template <typename T>
+bool scan_mapped_file(const char* path, size_t& values)
+{
+    scn::mapped_file file{path};
+    return scan_all<T>(file, values);
+}
+
+// Read with operator>>, through the streambuf in <scn/istream.h>
+template <typename T>
+struct istream_value {
+    T value;
+
+    friend std::istream& operator>>(std::istream& is, istream_value& v)
+    {
+        return is >> v.value;
+    }
+};
+
+template <typename T>
+bool scan_owning_file_istream(const char* path, size_t& values)
+{
+    scn::owning_file file{path, "r"};
+    return scan_all<istream_value<T>>(file, values);
+}
+
+template <typename T>
+bool scan_ifstream(const char* path, size_t& values)
+{
+    std::ifstream stream{path};
+    T val{};
+    while (stream >> val) {
+        benchmark::DoNotOptimize(val);
+        ++values;
+    }
+    return stream.eof();
+}
+
+// Runs `scan` over the whole file on every iteration.
+// With `state.range(0) != 0`, the file is evicted from the page cache before
+// every iteration ("cold"), otherwise it's read once before the loop ("warm").
+template <typename Scan>
+void run_source_benchmark(benchmark::State& state,
+                          const temp_file& file,
+                          Scan scan)
+{
+    const bool cold = state.range(0) != 0;
+    if (cold) {
+        if (!drop_page_cache(file)) {
+            state.SkipWithError("Dropping the page cache is not supported");
+            return;
+        }
+    }
+    else {
+        warm_page_cache(file);
+    }
+
+    size_t values = 0;
+    for (auto _ : state) {
+        if (cold) {
+            state.PauseTiming();
+            drop_page_cache(file);
+            state.ResumeTiming();
+        }
+        if (!scan(file.path(), values)) {
+            state.SkipWithError("Benchmark errored");
+            break;
+        }
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                            static_cast<int64_t>(file.size()));
+    state.SetItemsProcessed(static_cast<int64_t>(values));
+}
+
+#define SOURCE_BENCHMARK(f) BENCHMARK(f)->ArgName("cold")->Arg(0)->Arg(1)
+
+#endif  // SCN_BENCHMARK_SOURCE_H
@@ -0,0 +1,63 @@
+// Copyright 2017 Elias Kosunen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// This file is a part of scnlib:
+//     https://github.com/eliaskosunen/scnlib
+
+#include "bench_source.h"
+
+#include "../integer/bench_int.h"
+
+static const temp_file& int_file()
+{
+    static const temp_file file{"bench-source-int.txt",
+                                stringified_integer_list<int>()};
+    return file;
+}
+
+static void source_int_owning_file(benchmark::State& state)
+{
+    run_source_benchmark(state, int_file(), scan_owning_file<int>);
+}
+SOURCE_BENCHMARK(source_int_owning_file);
+
+static void source_int_file(benchmark::State& state)
+{
+    run_source_benchmark(state, int_file(), scan_file<int>);
+}
+SOURCE_BENCHMARK(source_int_file);
+
+static void source_int_cstdin(benchmark::State& state)
+{
+    run_source_benchmark(state, int_file(), scan_cstdin<int>);
+}
+SOURCE_BENCHMARK(source_int_cstdin);
+
+static void source_int_mapped_file(benchmark::State& state)
+{
+    run_source_benchmark(state, int_file(), scan_mapped_file<int>);
+}
+SOURCE_BENCHMARK(source_int_mapped_file);
+
+static void source_int_owning_file_istream(benchmark::State& state)
+{
+    run_source_benchmark(state, int_file(), scan_owning_file_istream<int>);
+}
+SOURCE_BENCHMARK(source_int_owning_file_istream);
+
+static void source_int_ifstream(benchmark::State& state)
+{
+    run_source_benchmark(state, int_file(), scan_ifstream<int>);
+}
+SOURCE_BENCHMARK(source_int_ifstream);
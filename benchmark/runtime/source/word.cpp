@@ -0,0 +1,64 @@
+// Copyright 2017 Elias Kosunen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// This file is a part of scnlib:
+//     https://github.com/eliaskosunen/scnlib
+
+#include "bench_source.h"
+
+#include "../word/bench_word.h"
+
+static const temp_file& word_file()
+{
+    static const temp_file file{"bench-source-word.txt",
+                                word_list<char>(2 << 15)};
+    return file;
+}
+
+static void source_word_owning_file(benchmark::State& state)
+{
+    run_source_benchmark(state, word_file(), scan_owning_file<std::string>);
+}
+SOURCE_BENCHMARK(source_word_owning_file);
+
+static void source_word_file(benchmark::State& state)
+{
+    run_source_benchmark(state, word_file(), scan_file<std::string>);
+}
+SOURCE_BENCHMARK(source_word_file);
+
+static void source_word_cstdin(benchmark::State& state)
+{
+    run_source_benchmark(state, word_file(), scan_cstdin<std::string>);
+}
+SOURCE_BENCHMARK(source_word_cstdin);
+
+static void source_word_mapped_file(benchmark::State& state)
+{
+    run_source_benchmark(state, word_file(), scan_mapped_file<std::string>);
+}
+SOURCE_BENCHMARK(source_word_mapped_file);
+
+static void source_word_owning_file_istream(benchmark::State& state)
+{
+    run_source_benchmark(state, word_file(),
+                         scan_owning_file_istream<std::string>);
+}
+SOURCE_BENCHMARK(source_word_owning_file_istream);
+
+static void source_word_ifstream(benchmark::State& state)
+{
+    run_source_benchmark(state, word_file(), scan_ifstream<std::string>);
+}
+SOURCE_BENCHMARK(source_word_ifstream);
@@ -0,0 +1,190 @@
+// Copyright 2017 Elias Kosunen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// This file is a part of scnlib:
+//     https://github.com/eliaskosunen/scnlib
+
+#ifndef SCN_BENCHMARK_SOURCES_H
+#define SCN_BENCHMARK_SOURCES_H
+
+#include "benchmark.h"
+
+#include <cstdio>
+#include <deque>
+#include <string>
+
+// Sources: each one provides range(), to be scanned until the end, and
+// reset(), to be called after that
+
+struct string_view_source {
+    explicit string_view_source(std::string d) : data(std::move(d)) {}
+
+    scn::string_view range() const
+    {
+        return {data.data(), data.size()};
+    }
+    void reset() {}
+
+    std::string data;
+};
+
+struct string_source {
+    explicit string_source(std::string d) : data(std::move(d)) {}
+
+    const std::string& range() const
+    {
+        return data;
+    }
+    void reset() {}
+
+    std::string data;
+};
+
+struct deque_source {
+    explicit deque_source(const std::string& d) : data(d.begin(), d.end()) {}
+
+    const std::deque<char>& range() const
+    {
+        return data;
+    }
+    void reset() {}
+
+    std::deque<char> data;
+};
+
+struct file_source {
+    explicit file_source(const std::string& d)
+    {
+        auto f = std::tmpfile();
+        std::fwrite(d.data(), 1, d.size(), f);
+        std::rewind(f);
+        file.set_handle(f);
+    }
+    file_source(const file_source&) = delete;
+    file_source& operator=(const file_source&) = delete;
+    ~file_source()
+    {
+        std::fclose(file.set_handle(nullptr));
+    }
+
+    scn::file& range()
+    {
+        return file;
+    }
+    void reset()
+    {
+        file.sync();
+        std::rewind(file.handle());
+    }
+
+    scn::file file{};
+};
+
+struct mapped_file_source {
+    explicit mapped_file_source(const std::string& d)
+        : file(write_file(d))
+    {
+    }
+    mapped_file_source(const mapped_file_source&) = delete;
+    mapped_file_source& operator=(const mapped_file_source&) = delete;
+    ~mapped_file_source()
+    {
+        std::remove(filename);
+    }
+
+    const scn::mapped_file& range() const
+    {
+        return file;
+    }
+    void reset() {}
+
+    static const char* write_file(const std::string& d)
+    {
+        auto f = std::fopen(filename, "wb");
+        std::fwrite(d.data(), 1, d.size(), f);
+        std::fclose(f);
+        return filename;
+    }
+
+    static constexpr const char* filename = "bench-mapped-source.txt";
+    scn::mapped_file file;
+};
+
+// Sources over an existing file at `path`, like the input given to
+// scn-bench. valid() is false if it couldn't be opened.
+
+struct path_mapped_file_source {
+    explicit path_mapped_file_source(const std::string& path)
+        : file(path.c_str())
+    {
+    }
+
+    bool valid() const
+    {
+        return file.valid();
+    }
+
+    const scn::mapped_file& range() const
+    {
+        return file;
+    }
+    void reset() {}
+
+    scn::mapped_file file;
+};
+
+struct path_file_source {
+    explicit path_file_source(const std::string& path)
+        : file(path.c_str(), "rb")
+    {
+    }
+
+    bool valid() const
+    {
+        return file.is_open();
+    }
+
+    scn::owning_file& range()
+    {
+        return file;
+    }
+    void reset()
+    {
+        file.sync();
+        std::rewind(file.handle());
+    }
+
+    scn::owning_file file;
+};
+
+// Can only be scanned once
+struct stdin_source {
+    scn::file& range()
+    {
+        return scn::cstdin();
+    }
+    void reset()
+    {
+        scn::cstdin().sync();
+    }
+};
+
+#define BENCHMARK_ALL_SOURCES(f)               \
+    BENCHMARK_TEMPLATE(f, string_view_source); \
+    BENCHMARK_TEMPLATE(f, string_source);      \
+    BENCHMARK_TEMPLATE(f, deque_source);       \
+    BENCHMARK_TEMPLATE(f, file_source);        \
+    BENCHMARK_TEMPLATE(f, mapped_file_source)
+
+#endif  // SCN_BENCHMARK_SOURCES_H
@@ -0,0 +1,107 @@
+// Copyright 2017 Elias Kosunen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// This file is a part of scnlib:
+//     https://github.com/eliaskosunen/scnlib
+
+#include "../other/bench_other.h"
+
+#include <scn/tuple_return.h>
+
+// An integer and a word on every line
+template <typename Char>
+std::basic_string<Char> int_and_word_list(size_t n = OTHER_DATA_N)
+{
+    auto ints = separated_int_list<char>(n);
+    auto words = lines_list<char>(n, 1);
+
+    std::string ret;
+    std::istringstream int_stream{ints}, word_stream{words};
+    std::string i, w;
+    while (int_stream >> i && word_stream >> w) {
+        ret += i;
+        ret.push_back(' ');
+        ret += w;
+        ret.push_back('\n');
+    }
+    return widen_ascii<Char>(ret);
+}
+
+template <typename Char>
+static void scan_tuple_scn(benchmark::State& state)
+{
+    auto data = int_and_word_list<Char>();
+    auto result = scn::make_result(data);
+    int i{};
+    std::basic_string<Char> str{};
+    for (auto _ : state) {
+        std::tie(result, i, str) =
+            scn::scan_tuple<int, std::basic_string<Char>>(
+                result.range(), BENCH_LITERAL(Char, "{} {}"));
+
+        if (!result) {
+            if (result.error() == scn::error::end_of_range) {
+                result = scn::make_result(data);
+            }
+            else {
+                state.SkipWithError("Benchmark errored");
+                break;
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(scan_tuple_scn, char);
+BENCHMARK_TEMPLATE(scan_tuple_scn, wchar_t);
+
+template <typename Char>
+static void scan_tuple_scn_default(benchmark::State& state)
+{
+    auto data = int_and_word_list<Char>();
+    auto result = scn::make_result(data);
+    int i{};
+    std::basic_string<Char> str{};
+    for (auto _ : state) {
+        std::tie(result, i, str) =
+            scn::scan_tuple_default<int, std::basic_string<Char>>(
+                result.range());
+
+        if (!result) {
+            if (result.error() == scn::error::end_of_range) {
+                result = scn::make_result(data);
+            }
+            else {
+                state.SkipWithError("Benchmark errored");
+                break;
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(scan_tuple_scn_default, char);
+BENCHMARK_TEMPLATE(scan_tuple_scn_default, wchar_t);
+
+// Same values through scn::scan, for comparison
+template <typename Char>
+static void scan_tuple_scn_scan(benchmark::State& state)
+{
+    auto data = int_and_word_list<Char>();
+    int i{};
+    std::basic_string<Char> str{};
+    run_repeated(state, data, [&](auto& range) {
+        return scn::scan(range, BENCH_LITERAL(Char, "{} {}"), i, str);
+    });
+}
+BENCHMARK_TEMPLATE(scan_tuple_scn_scan, char);
+BENCHMARK_TEMPLATE(scan_tuple_scn_scan, wchar_t);
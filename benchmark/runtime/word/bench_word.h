@@ -20,9 +20,11 @@
 
 #include "../benchmark.h"
 
+#include <algorithm>
 #include <cstdio>
 #include <limits>
 #include <sstream>
+#include <string>
 #include <vector>
 
 template <typename CharT>
@@ -87,38 +89,83 @@ template <typename Char>
 std::vector<std::basic_string<Char>> words_list(size_t n)
 {
     static const auto& chars = chars_nospaces<Char>();
-    static std::uniform_int_distribution<> dist(
-        0, static_cast<int>(chars.size() - 1));
+    std::uniform_int_distribution<> dist(0,
+                                         static_cast<int>(chars.size() - 1));
+    auto rng = make_rng();
 
     std::vector<std::basic_string<Char>> ret;
     ret.reserve(n);
     for (size_t i = 0; i < n; ++i) {
-        auto len = dist(get_rng());
+        auto len = dist(rng);
         if (len == 0) {
             len = 3;
         }
         std::basic_string<Char> str;
         str.reserve(static_cast<size_t>(len));
         for (int j = 0; j < len; ++j) {
-            str.push_back(chars[static_cast<size_t>(dist(get_rng()))]);
+            str.push_back(chars[static_cast<size_t>(dist(rng))]);
         }
         ret.push_back(std::move(str));
     }
     return ret;
 }
+
+// `n` characters, of which about one in six is whitespace
+inline std::string word_corpus(size_t n)
+{
+    return load_corpus("word-" + std::to_string(n),
+                       [n](std::mt19937_64& rng) {
+                           const auto& chars = chars_spaces<char>();
+                           std::uniform_int_distribution<> dist(
+                               0, static_cast<int>(chars.size() - 1));
+
+                           std::string ret;
+                           ret.reserve(n);
+                           for (size_t i = 0; i < n; ++i) {
+                               ret.push_back(
+                                   chars[static_cast<size_t>(dist(rng))]);
+                           }
+                           return ret;
+                       });
+}
+
+// `n` words separated by a single space or newline, with geometrically
+// distributed lengths: most words are short, a few are long,
+// as in natural language text
+inline std::string skewed_word_corpus(size_t n)
+{
+    return load_corpus(
+        "word-skewed-" + std::to_string(n), [n](std::mt19937_64& rng) {
+            const auto& chars = chars_nospaces<char>();
+            std::uniform_int_distribution<> dist(
+                0, static_cast<int>(chars.size() - 1));
+            std::geometric_distribution<> length(0.25);
+            std::bernoulli_distribution newline(0.1);
+
+            std::string ret;
+            for (size_t i = 0; i < n; ++i) {
+                const auto len = std::min(length(rng) + 1, 64);
+                for (int j = 0; j < len; ++j) {
+                    ret.push_back(chars[static_cast<size_t>(dist(rng))]);
+                }
+                ret.push_back(newline(rng) ? '\n' : ' ');
+            }
+            return ret;
+        });
+}
+
 template <typename Char>
 std::basic_string<Char> word_list(size_t n)
 {
-    static const auto& chars = chars_spaces<Char>();
-    static std::uniform_int_distribution<> dist(
-        0, static_cast<int>(chars.size() - 1));
+    auto corpus = word_corpus(n);
+    return {corpus.begin(), corpus.end()};
+}
 
-    std::basic_string<Char> ret;
-    ret.reserve(n);
-    for (size_t i = 0; i < n; ++i) {
-        ret.push_back(chars[static_cast<size_t>(dist(get_rng()))]);
-    }
-    return ret;
+template <typename Char>
+std::basic_string<Char> skewed_word_list(size_t n)
+{
+    auto corpus = skewed_word_corpus(n);
+    return {corpus.begin(), corpus.end()};
 }
 
 template <typename Char>
@@ -0,0 +1,104 @@
+// Copyright 2017 Elias Kosunen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// This file is a part of scnlib:
+//     https://github.com/eliaskosunen/scnlib
+
+#include "bench_word.h"
+
+#define SKEWED_WORD_DATA_N (2 << 10)
+
+// Words with geometrically distributed lengths, as in natural language text
+
+template <typename Char>
+static void scan_word_skewed_scn(benchmark::State& state)
+{
+    auto data = skewed_word_list<Char>(SKEWED_WORD_DATA_N);
+    std::basic_string<Char> str{};
+    auto result = scn::make_result(data);
+    size_t size = 0;
+    for (auto _ : state) {
+        result = scn::scan_default(result.range(), str);
+
+        if (!result) {
+            if (result.error() == scn::error::end_of_range) {
+                result = scn::make_result(data);
+            }
+            else {
+                state.SkipWithError("Benchmark errored");
+                break;
+            }
+        }
+        else {
+            size += str.size();
+        }
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(size * sizeof(Char)));
+}
+BENCHMARK_TEMPLATE(scan_word_skewed_scn, char);
+BENCHMARK_TEMPLATE(scan_word_skewed_scn, wchar_t);
+
+template <typename Char>
+static void scan_word_skewed_scn_view(benchmark::State& state)
+{
+    auto data = skewed_word_list<Char>(SKEWED_WORD_DATA_N);
+    scn::basic_string_view<Char> str{};
+    auto result = scn::make_result(data);
+    size_t size = 0;
+    for (auto _ : state) {
+        result = scn::scan_default(result.range(), str);
+
+        if (!result) {
+            if (result.error() == scn::error::end_of_range) {
+                result = scn::make_result(data);
+            }
+            else {
+                state.SkipWithError("Benchmark errored");
+                break;
+            }
+        }
+        else {
+            size += str.size();
+        }
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(size * sizeof(Char)));
+}
+BENCHMARK_TEMPLATE(scan_word_skewed_scn_view, char);
+BENCHMARK_TEMPLATE(scan_word_skewed_scn_view, wchar_t);
+
+template <typename Char>
+static void scan_word_skewed_sstream(benchmark::State& state)
+{
+    auto data = skewed_word_list<Char>(SKEWED_WORD_DATA_N);
+    auto stream = std::basic_istringstream<Char>(data);
+    std::basic_string<Char> str{};
+    size_t size = 0;
+    for (auto _ : state) {
+        stream >> str;
+
+        if (stream.eof()) {
+            stream = std::basic_istringstream<Char>(data);
+        }
+        else if (stream.fail()) {
+            state.SkipWithError("Benchmark errored");
+            break;
+        }
+        else {
+            size += str.size();
+        }
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(size * sizeof(Char)));
+}
+BENCHMARK_TEMPLATE(scan_word_skewed_sstream, char);
+BENCHMARK_TEMPLATE(scan_word_skewed_sstream, wchar_t);
@@ -29,6 +29,14 @@ if (SCN_USE_MSAN)
             -g -fno-omit-frame-pointer)
 endif ()
 
+if (SCN_USE_USDT)
+    include(CheckIncludeFileCXX)
+    check_include_file_cxx(sys/sdt.h SCN_HAS_SYS_SDT_H)
+    if (NOT SCN_HAS_SYS_SDT_H)
+        message(FATAL_ERROR "SCN_USE_USDT requires <sys/sdt.h> (systemtap-sdt-dev)")
+    endif ()
+endif ()
+
 string(REPLACE ";" "," SCN_SANITIZERS_COMPILE_FLAGS_JOINED "${SCN_SANITIZERS_COMPILE_FLAGS}")
 string(REPLACE ";" "," SCN_SANITIZERS_LINK_FLAGS_JOINED "${SCN_SANITIZERS_LINK_FLAGS}")
 list(LENGTH SCN_SANITIZERS_COMPILE_FLAGS sanitizers_compiler_list_length)
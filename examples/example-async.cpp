@@ -0,0 +1,172 @@
+// Copyright 2017 Elias Kosunen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// This file is a part of scnlib:
+//     https://github.com/eliaskosunen/scnlib
+
+// Scans several connections on a single thread:
+// each connection is a coroutine, suspended while its socket has no data.
+
+#include <scn/scn.h>
+#include <scn/scan/async.h>
+
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+class epoll_executor {
+public:
+    struct awaiter {
+        epoll_executor& ex;
+        int fd;
+
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
+        void await_suspend(std::coroutine_handle<> h)
+        {
+            ex.m_waiting[fd] = h;
+            epoll_event ev{};
+            ev.events = EPOLLIN | EPOLLONESHOT;
+            ev.data.fd = fd;
+            if (epoll_ctl(ex.m_epoll, EPOLL_CTL_MOD, fd, &ev) != 0) {
+                epoll_ctl(ex.m_epoll, EPOLL_CTL_ADD, fd, &ev);
+            }
+        }
+        void await_resume() const noexcept {}
+    };
+
+    epoll_executor() : m_epoll(epoll_create1(0)) {}
+    ~epoll_executor()
+    {
+        close(m_epoll);
+    }
+
+    awaiter readable(int fd)
+    {
+        return {*this, fd};
+    }
+
+    // Runs until no coroutine is waiting for input
+    void run()
+    {
+        while (!m_waiting.empty()) {
+            epoll_event evs[64];
+            int n = epoll_wait(m_epoll, evs, 64, -1);
+            for (int i = 0; i < n; ++i) {
+                auto it = m_waiting.find(evs[i].data.fd);
+                auto h = it->second;
+                m_waiting.erase(it);
+                h.resume();
+            }
+        }
+    }
+
+private:
+    int m_epoll;
+    std::map<int, std::coroutine_handle<>> m_waiting{};
+};
+
+using source_type = scn::async_fd_source<epoll_executor>;
+
+SCN_GCC_PUSH
+SCN_GCC_IGNORE("-Wswitch-default")
+
+// Reads "<name> <value>" records until EOF
+static scn::async_task<scn::error> handle_connection(int id, source_type& src)
+{
+    std::string name;
+    double value{};
+    while (true) {
+        auto e = co_await scn::async_scan(src, "{} {}", name, value);
+        if (e.code() == scn::error::end_of_range) {
+            co_return {};
+        }
+        if (!e) {
+            co_return e;
+        }
+        std::cout << "connection " << id << ": " << name << " = " << value
+                  << '\n';
+    }
+}
+
+SCN_GCC_POP
+
+int main()
+{
+    constexpr int n_connections = 3;
+    epoll_executor ex{};
+
+    std::vector<std::thread> writers;
+    std::vector<std::unique_ptr<source_type>> sources;
+    std::vector<scn::async_task<scn::error>> tasks;
+    std::vector<int> fds;
+
+    for (int i = 0; i < n_connections; ++i) {
+        int sv[2];
+        if (socketpair(AF_UNIX, SOCK_STREAM, 0, sv) != 0) {
+            return 1;
+        }
+        fcntl(sv[0], F_SETFL, fcntl(sv[0], F_GETFL) | O_NONBLOCK);
+        fds.push_back(sv[0]);
+
+        // The peer sends records in small pieces, split mid-token
+        writers.emplace_back([fd = sv[1], i]() {
+            std::string data = "temperature " + std::to_string(20 + i) +
+                               ".5\nhumidity 0." + std::to_string(40 + i) +
+                               "\n";
+            for (size_t pos = 0; pos < data.size(); pos += 5) {
+                auto n = std::min<size_t>(5, data.size() - pos);
+                if (write(fd, data.data() + pos, n) < 0) {
+                    break;
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+            close(fd);
+        });
+
+        sources.push_back(std::make_unique<source_type>(ex, sv[0]));
+        tasks.push_back(handle_connection(i, *sources.back()));
+        tasks.back().start();
+    }
+
+    ex.run();
+
+    for (auto& w : writers) {
+        w.join();
+    }
+    for (auto fd : fds) {
+        close(fd);
+    }
+    for (auto& t : tasks) {
+        if (!t.done()) {
+            return 1;
+        }
+        if (!t.result()) {
+            std::cout << "Error: " << t.result().msg() << '\n';
+            return 1;
+        }
+    }
+}
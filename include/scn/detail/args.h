@@ -326,7 +326,7 @@ namespace scn {
 
         SCN_NODISCARD constexpr detail::type type() const noexcept
         {
-            return type;
+            return m_type;
         }
         SCN_NODISCARD constexpr bool is_integral() const noexcept
         {
@@ -23,6 +23,7 @@
 #define SCN_STD_11 201103L
 #define SCN_STD_14 201402L
 #define SCN_STD_17 201703L
+#define SCN_STD_20 202002L
 
 #define SCN_COMPILER(major, minor, patch) \
     ((major)*10000000 /* 10,000,000 */ + (minor)*10000 /* 10,000 */ + (patch))
@@ -290,6 +291,14 @@
 #define SCN_HAS_STRING_VIEW 0
 #endif
 
+// Detect coroutines
+#if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902 && \
+    SCN_HAS_INCLUDE(<coroutine>) && SCN_STD >= SCN_STD_20
+#define SCN_HAS_COROUTINES 1
+#else
+#define SCN_HAS_COROUTINES 0
+#endif
+
 // Detect [[nodiscard]]
 #if (SCN_HAS_CPP_ATTRIBUTE(nodiscard) && __cplusplus >= SCN_STD_17) ||      \
     (SCN_MSVC >= SCN_COMPILER(19, 11, 0) && SCN_MSVC_LANG >= SCN_STD_17) || \
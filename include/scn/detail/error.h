@@ -59,6 +59,10 @@ namespace scn {
 
             unrecoverable_internal_error,
 
+            /// The input ended in the middle of a value, and more of it is
+            /// expected to follow, see `basic_push_scanner`
+            need_more_input,
+
             max_error
         };
 
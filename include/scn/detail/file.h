@@ -18,6 +18,7 @@
 #ifndef SCN_DETAIL_FILE_H
 #define SCN_DETAIL_FILE_H
 
+#include <cstdint>
 #include <cstdio>
 #include <string>
 
@@ -40,6 +41,19 @@ namespace scn {
             handle_type handle;
         };
 
+        /**
+         * Reads at most `buf.size()` bytes from the non-blocking file
+         * descriptor `fd` with `read()`, retrying on `EINTR`.
+         *
+         * \return The number of bytes read, `0` on EOF, or `-1` if the read
+         * would block (`EAGAIN`).
+         * `error::source_error` if `read()` failed, and
+         * `error::invalid_operation` on platforms without `read()`.
+         */
+        SCN_FUNC expected<std::ptrdiff_t> read_nonblocking(
+            native_file_handle fd,
+            span<char> buf);
+
         class byte_mapped_file {
         public:
             using iterator = const char*;
@@ -111,6 +125,60 @@ namespace scn {
                 native_file_handle::invalid().handle};
 #endif
         };
+
+        /**
+         * A file opened for reading at arbitrary offsets, without a file
+         * position of its own (`pread()` on POSIX).
+         * Used for following a growing file, see `basic_tail_file`.
+         */
+        class byte_tail_file {
+        public:
+            byte_tail_file() = default;
+            explicit byte_tail_file(const char* filename);
+
+            byte_tail_file(const byte_tail_file&) = delete;
+            byte_tail_file& operator=(const byte_tail_file&) = delete;
+
+            byte_tail_file(byte_tail_file&& o) noexcept
+                : m_file(exchange(o.m_file, native_file_handle::invalid()))
+            {
+            }
+            byte_tail_file& operator=(byte_tail_file&& o) noexcept
+            {
+                if (valid()) {
+                    _destruct();
+                }
+                m_file = exchange(o.m_file, native_file_handle::invalid());
+                return *this;
+            }
+
+            ~byte_tail_file()
+            {
+                if (valid()) {
+                    _destruct();
+                }
+            }
+
+            SCN_NODISCARD bool valid() const
+            {
+                return m_file.handle != native_file_handle::invalid().handle;
+            }
+
+            /// Current size of the file, in bytes
+            SCN_NODISCARD expected<std::uint64_t> file_size() const;
+
+            /**
+             * Reads at most `buf.size()` bytes, starting from `offset`.
+             * \return The number of bytes read, `0` at the end of the file.
+             */
+            SCN_NODISCARD expected<std::size_t> read_at(std::uint64_t offset,
+                                                        span<char> buf) const;
+
+        protected:
+            void _destruct();
+
+            native_file_handle m_file{native_file_handle::invalid().handle};
+        };
     }  // namespace detail
 
     /**
@@ -107,6 +107,8 @@ namespace scn {
     namespace detail {
         template <typename T>
         struct simple_integer_scanner;
+        template <typename T>
+        struct float_scanner_access;
     }
 
     // visitor.h
@@ -123,6 +125,11 @@ namespace scn {
     template <typename CharT>
     class basic_owning_file;
 
+    // validated_view.h
+
+    template <typename CharT, bool Ascii>
+    class basic_validated_view;
+
     // scan.h
 
     template <typename T>
@@ -367,6 +367,28 @@ namespace scn {
             }
         };
 
+        /**
+         * Character classes of a custom locale, as returned by
+         * `basic_custom_locale_ref::classify()`.
+         * Mirrors `std::ctype_base::mask`.
+         */
+        struct ctype_class {
+            enum : uint16_t {
+                alnum = 1u << 0u,
+                alpha = 1u << 1u,
+                blank = 1u << 2u,
+                cntrl = 1u << 3u,
+                digit = 1u << 4u,
+                graph = 1u << 5u,
+                lower = 1u << 6u,
+                print = 1u << 7u,
+                punct = 1u << 8u,
+                space = 1u << 9u,
+                upper = 1u << 10u,
+                xdigit = 1u << 11u
+            };
+        };
+
         // custom
         template <typename CharT>
         class basic_custom_locale_ref final
@@ -433,6 +455,28 @@ namespace scn {
             bool is_digit(code_point) const;
             using base::is_digit;
 
+            /**
+             * Returns the character classes of a code unit, code point, or
+             * an encoded code point, as a combination of `ctype_class`
+             * values.
+             *
+             * Looked up from tables built when `*this` is initialized.
+             * Classes of BMP code points outside of U+0000-U+00FF are
+             * cached on first use, other code points are classified with
+             * the `std::ctype` facet of the locale.
+             */
+            uint16_t classify(char_type ch) const;
+            uint16_t classify(code_point cp) const;
+            uint16_t classify(span<const char_type> ch) const
+            {
+                SCN_EXPECT(ch.size() >= 1);
+                const auto c = static_cast<uint32_t>(ch[0]);
+                if (c < 0x80) {
+                    return m_ascii_classes[c];
+                }
+                return _classify(ch);
+            }
+
             template <typename T>
             expected<std::ptrdiff_t> read_num(T& val,
                                               const string_type& buf,
@@ -453,12 +497,121 @@ namespace scn {
             string_view_type do_falsename() const override;
 
             void _initialize();
+            uint16_t _classify(span<const char_type> ch) const;
 
             const void* m_locale{nullptr};
             void* m_data{nullptr};
+            const uint16_t* m_ascii_classes{nullptr};
         };
+
+        template <typename CharT>
+        struct shared_locale_node;
+
+        // Get the node for the std::locale pointed to by `locale` from the
+        // process-wide cache, creating it if necessary.
+        // The reference count of the returned node is incremented.
+        template <typename CharT>
+        shared_locale_node<CharT>* acquire_shared_locale(const void* locale);
+        template <typename CharT>
+        void retain_shared_locale(shared_locale_node<CharT>* node);
+        template <typename CharT>
+        void release_shared_locale(shared_locale_node<CharT>* node);
+        template <typename CharT>
+        const basic_custom_locale_ref<CharT>& get_shared_locale(
+            shared_locale_node<CharT>* node);
     }  // namespace detail
 
+    template <typename CharT>
+    class basic_locale_ref;
+
+    /**
+     * An immutable, reference-counted handle to a locale, prepared for
+     * scanning: its facet data and character classification tables are
+     * read once, and shared by every copy of the handle.
+     *
+     * Handles are looked up from a process-wide cache, keyed by the
+     * identity of the `std::locale` (see `std::locale::operator==`), so
+     * constructing one for a locale already in use is cheap.
+     * Handles can be shared between threads.
+     *
+     * `scan_localized` uses this cache internally, but a handle
+     * constructed up-front can also be passed to it in place of a
+     * `std::locale`.
+     *
+     * \code{.cpp}
+     * auto loc = scn::shared_locale{std::locale{"fi_FI"}};
+     * double d;
+     * scn::scan_localized(loc, "3,14", "{:L}", d);
+     * \endcode
+     */
+    template <typename CharT>
+    class basic_shared_locale {
+    public:
+        using char_type = CharT;
+        using custom_type = detail::basic_custom_locale_ref<char_type>;
+
+        constexpr basic_shared_locale() = default;
+
+        /**
+         * \param loc `std::locale` to use. The parameter is a template to
+         * avoid inclusion of `<locale>`.
+         */
+        template <typename Locale>
+        explicit basic_shared_locale(const Locale& loc)
+            : m_node(detail::acquire_shared_locale<CharT>(std::addressof(loc)))
+        {
+        }
+
+        basic_shared_locale(const basic_shared_locale& o) : m_node(o.m_node)
+        {
+            if (m_node) {
+                detail::retain_shared_locale(m_node);
+            }
+        }
+        basic_shared_locale& operator=(const basic_shared_locale& o)
+        {
+            basic_shared_locale tmp{o};
+            std::swap(m_node, tmp.m_node);
+            return *this;
+        }
+        basic_shared_locale(basic_shared_locale&& o) noexcept
+            : m_node(o.m_node)
+        {
+            o.m_node = nullptr;
+        }
+        basic_shared_locale& operator=(basic_shared_locale&& o) noexcept
+        {
+            std::swap(m_node, o.m_node);
+            return *this;
+        }
+        ~basic_shared_locale()
+        {
+            if (m_node) {
+                detail::release_shared_locale(m_node);
+            }
+        }
+
+        constexpr explicit operator bool() const noexcept
+        {
+            return m_node != nullptr;
+        }
+
+        /// Prepared locale
+        const custom_type& get() const
+        {
+            SCN_EXPECT(m_node);
+            return detail::get_shared_locale(m_node);
+        }
+
+    private:
+        friend class basic_locale_ref<CharT>;
+
+        detail::shared_locale_node<CharT>* m_node{nullptr};
+    };
+
+    using shared_locale = basic_shared_locale<char>;
+    using wshared_locale = basic_shared_locale<wchar_t>;
+
     template <typename CharT>
     class basic_locale_ref {
     public:
@@ -482,8 +635,21 @@ namespace scn {
         // nullptr = global
         constexpr basic_locale_ref(const void* p) : m_payload(p) {}
 
+        // prepared, shared locale
+        basic_locale_ref(basic_shared_locale<CharT> shared)
+            : m_shared(SCN_MOVE(shared))
+        {
+            if (m_shared) {
+                m_shared_custom = &detail::get_shared_locale(m_shared.m_node);
+                m_payload = m_shared_custom->get_locale();
+            }
+        }
+
         basic_locale_ref clone() const
         {
+            if (m_shared) {
+                return {m_shared};
+            }
             return {m_payload};
         }
 
@@ -502,14 +668,14 @@ namespace scn {
             return m_default;
         }
 
-        // global locale or given locale
-        custom_type& get_localized()
-        {
-            _construct_custom();
-            return *m_custom;
-        }
+        // global locale or given locale.
+        // Only const access is given, because a shared locale is used by
+        // every thread scanning with it at the same time.
         const custom_type& get_localized() const
         {
+            if (m_shared_custom) {
+                return *m_shared_custom;
+            }
             _construct_custom();
             return *m_custom;
         }
@@ -519,23 +685,12 @@ namespace scn {
             return custom_type::make_classic();
         }
 
-        custom_type* get_localized_unsafe()
-        {
-            return m_custom.get();
-        }
         const custom_type* get_localized_unsafe() const
         {
-            return m_custom.get();
+            return m_shared_custom ? m_shared_custom : m_custom.get();
         }
 
         // virtual interface
-        impl_base& get(bool localized)
-        {
-            if (localized) {
-                return get_localized();
-            }
-            return get_default();
-        }
         const impl_base& get(bool localized) const
         {
             if (localized) {
@@ -551,6 +706,8 @@ namespace scn {
         void reset_locale(const void* payload)
         {
             m_custom.reset();
+            m_shared = {};
+            m_shared_custom = nullptr;
             m_payload = payload;
             _construct_custom();
         }
@@ -558,7 +715,7 @@ namespace scn {
     private:
         void _construct_custom() const
         {
-            if (m_custom) {
+            if (m_custom || m_shared_custom) {
                 // already constructed
                 return;
             }
@@ -569,6 +726,8 @@ namespace scn {
 
         mutable detail::unique_ptr<custom_type> m_custom{nullptr};
         const void* m_payload{nullptr};
+        basic_shared_locale<CharT> m_shared{};
+        const custom_type* m_shared_custom{nullptr};
         default_type m_default{};
 #endif
     };
@@ -576,7 +735,13 @@ namespace scn {
     template <typename CharT, typename Locale>
     basic_locale_ref<CharT> make_locale_ref(const Locale& loc)
     {
-        return {std::addressof(loc)};
+        return {basic_shared_locale<CharT>{loc}};
+    }
+    template <typename CharT>
+    basic_locale_ref<CharT> make_locale_ref(
+        const basic_shared_locale<CharT>& loc)
+    {
+        return {loc};
     }
     template <typename CharT>
     basic_locale_ref<CharT> make_default_locale_ref()
@@ -128,6 +128,25 @@ namespace scn {
             }
             return true;
         }
+        /**
+         * Returns the code units of the literal starting from `begin()`:
+         * `next_char()`, and every character after it, up to the next
+         * whitespace character or brace. `good()` must be `true`.
+         */
+        SCN_NODISCARD span<const char_type> literal_run() const
+        {
+            SCN_EXPECT(good());
+            std::size_t n = 1;
+            for (; n < chars_left(); ++n) {
+                const auto ch = m_str[n];
+                if (ch == detail::ascii_widen<char_type>('{') ||
+                    ch == detail::ascii_widen<char_type>('}') ||
+                    m_locale.get_static().is_space(ch)) {
+                    break;
+                }
+            }
+            return {m_str.data(), n};
+        }
         /**
          * Returns `true` if `cp` is equal to the value returned by `next_cp()`.
          * If `next_cp()` errored, returns that error
@@ -410,6 +429,10 @@ namespace scn {
         {
             return false;
         }
+        constexpr span<const char_type> literal_run() const
+        {
+            return {};
+        }
 
         constexpr bool good() const
         {
@@ -22,6 +22,7 @@
 #include "../util/algorithm.h"
 #include "../util/memory.h"
 #include "error.h"
+#include "stats.h"
 #include "vectored.h"
 
 namespace scn {
@@ -162,6 +163,20 @@ namespace scn {
             }
         };
 
+        template <typename Range, typename = void>
+        struct assumed_encoding_impl {
+            static constexpr bool valid = false;
+            static constexpr bool ascii = false;
+        };
+        template <typename Range>
+        struct assumed_encoding_impl<
+            Range,
+            void_t<decltype(Range::assume_valid_encoding),
+                   decltype(Range::assume_ascii)>> {
+            static constexpr bool valid = Range::assume_valid_encoding;
+            static constexpr bool ascii = Range::assume_ascii;
+        };
+
         template <typename T>
         using _range_wrapper_marker = typename T::range_wrapper_marker;
 
@@ -201,41 +216,33 @@ namespace scn {
 
             range_wrapper(const range_wrapper& o) : m_range(o.m_range)
             {
-                const auto n =
-                    ranges::distance(o.begin_underlying(), o.m_begin);
-                m_begin = ranges::cbegin(m_range.get());
-                ranges::advance(m_begin, n);
+                _copy_begin(o, o._begin_offset(is_stored_by_reference{}),
+                            is_stored_by_reference{});
                 m_read = o.m_read;
             }
             range_wrapper& operator=(const range_wrapper& o)
             {
-                const auto n =
-                    ranges::distance(o.begin_underlying(), o.m_begin);
+                const auto n = o._begin_offset(is_stored_by_reference{});
                 m_range = o.m_range;
-                m_begin = ranges::cbegin(m_range.get());
-                ranges::advance(m_begin, n);
+                _copy_begin(o, n, is_stored_by_reference{});
                 m_read = o.m_read;
                 return *this;
             }
 
             range_wrapper(range_wrapper&& o) noexcept
             {
-                const auto n =
-                    ranges::distance(o.begin_underlying(), o.m_begin);
+                const auto n = o._begin_offset(is_stored_by_reference{});
                 m_range = SCN_MOVE(o.m_range);
-                m_begin = ranges::cbegin(m_range.get());
-                ranges::advance(m_begin, n);
+                _copy_begin(o, n, is_stored_by_reference{});
                 m_read = exchange(o.m_read, 0);
             }
             range_wrapper& operator=(range_wrapper&& o) noexcept
             {
                 reset_to_rollback_point();
 
-                const auto n =
-                    ranges::distance(o.begin_underlying(), o.m_begin);
+                const auto n = o._begin_offset(is_stored_by_reference{});
                 m_range = SCN_MOVE(o.m_range);
-                m_begin = ranges::cbegin(m_range.get());
-                ranges::advance(m_begin, n);
+                _copy_begin(o, n, is_stored_by_reference{});
                 m_read = exchange(o.m_read, 0);
                 return *this;
             }
@@ -275,6 +282,7 @@ namespace scn {
                     n, std::integral_constant<bool, is_contiguous>{}));
                 m_read += n;
                 ranges::advance(m_begin, n);
+                SCN_STATS_ADD(code_units_read, n > 0 ? n : 0);
                 return m_begin;
             }
 
@@ -292,6 +300,7 @@ namespace scn {
                 const auto diff = ranges::distance(m_begin, it);
                 m_read += diff;
                 m_begin = it;
+                SCN_STATS_ADD(code_units_read, diff);
             }
             template <typename R = range_nocvref_type,
                       typename std::enable_if<SCN_CHECK_CONCEPT(
@@ -301,6 +310,7 @@ namespace scn {
                 while (m_begin != it) {
                     ++m_read;
                     ++m_begin;
+                    SCN_STATS_ADD(code_units_read, 1);
                 }
             }
             /// @}
@@ -385,6 +395,8 @@ namespace scn {
              */
             error reset_to_rollback_point()
             {
+                SCN_STATS_ADD(rollbacks, 1);
+                SCN_STATS_ADD(rollback_code_units, m_read);
                 for (; m_read != 0; --m_read) {
                     --m_begin;
                     if (m_begin == end()) {
@@ -441,8 +453,49 @@ namespace scn {
              */
             static constexpr bool provides_buffer_access =
                 provides_buffer_access_impl<range_nocvref_type>::value;
+            /**
+             * `true` if the range is known to be validly encoded, so that the
+             * code points read from it don't need to be validated, see
+             * `basic_validated_view`.
+             */
+            static constexpr bool assume_valid_encoding =
+                assumed_encoding_impl<range_nocvref_type>::valid;
+            /**
+             * `true` if the range is known to only contain ASCII, so that
+             * every code unit is a code point.
+             */
+            static constexpr bool assume_ascii =
+                assumed_encoding_impl<range_nocvref_type>::ascii;
 
         private:
+            using is_stored_by_reference = std::is_reference<Range>;
+
+            // When the source range is stored by reference, copying or moving
+            // *this doesn't change the range, so m_begin stays valid.
+            // Otherwise, m_begin is recreated at the same offset, which is
+            // linear for non-random-access iterators.
+            difference_type _begin_offset(std::true_type) const noexcept
+            {
+                return 0;
+            }
+            difference_type _begin_offset(std::false_type) const noexcept
+            {
+                return ranges::distance(begin_underlying(), m_begin);
+            }
+            void _copy_begin(const range_wrapper& o,
+                             difference_type,
+                             std::true_type) noexcept
+            {
+                m_begin = o.m_begin;
+            }
+            void _copy_begin(const range_wrapper&,
+                             difference_type n,
+                             std::false_type) noexcept
+            {
+                m_begin = ranges::cbegin(m_range.get());
+                ranges::advance(m_begin, n);
+            }
+
             template <typename R = Range>
             bool _advance_check(std::ptrdiff_t n, std::true_type)
             {
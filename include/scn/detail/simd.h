@@ -0,0 +1,97 @@
+// Copyright 2017 Elias Kosunen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// This file is a part of scnlib:
+//     https://github.com/eliaskosunen/scnlib
+
+#ifndef SCN_DETAIL_SIMD_H
+#define SCN_DETAIL_SIMD_H
+
+#include "fwd.h"
+
+namespace scn {
+    SCN_BEGIN_NAMESPACE
+
+    namespace detail {
+        /**
+         * Instruction set extensions used by the vectorized kernels below.
+         *
+         * The best level supported by the CPU is detected once, on first
+         * use, so that portable binaries (without `SCN_USE_NATIVE_ARCH`) use
+         * vector instructions too.
+         * Only x86 with gcc or clang has vectorized kernels: elsewhere, the
+         * level is always `none`.
+         */
+        enum class simd_level : unsigned char {
+            none = 0,
+            sse2,
+            sse42,
+            avx2,
+            avx512
+        };
+
+        /// Best level supported by the CPU
+        SCN_FUNC simd_level detected_simd_level() noexcept;
+        /// Level currently used by the kernels
+        SCN_FUNC simd_level active_simd_level() noexcept;
+        /**
+         * Make the kernels use `level`, or `detected_simd_level()`, if the
+         * CPU doesn't support it. Returns the level that was set.
+         *
+         * Not thread-safe with concurrent scanning: only meant for testing
+         * and benchmarking the different kernels.
+         */
+        SCN_FUNC simd_level set_simd_level(simd_level level) noexcept;
+
+        /// @{
+        /**
+         * Kernels over `[begin, end)`.
+         * Each returns a pointer to the first character satisfying the
+         * condition, or `end`, if there are none.
+         */
+
+        /// First space character (in the "C" locale)
+        SCN_FUNC const char* find_classic_space(const char* begin,
+                                                const char* end) noexcept;
+        /// First character that is not a space (in the "C" locale)
+        SCN_FUNC const char* find_classic_nonspace(const char* begin,
+                                                   const char* end) noexcept;
+        /// First code unit equal to `ch`
+        SCN_FUNC const char* find_char(const char* begin,
+                                       const char* end,
+                                       char ch) noexcept;
+        /// First non-ASCII code unit, i.e. the start of a multibyte UTF-8
+        /// sequence, or an invalid code unit
+        SCN_FUNC const char* find_non_ascii(const char* begin,
+                                            const char* end) noexcept;
+        /// @}
+
+        /**
+         * First code unit that doesn't begin a valid UTF-8 sequence:
+         * a stray continuation byte, a truncated, overlong or out of range
+         * sequence, or an encoded surrogate.
+         * Runs of ASCII are skipped with `find_non_ascii()`.
+         */
+        SCN_FUNC const char* find_invalid_utf8(const char* begin,
+                                               const char* end) noexcept;
+    }  // namespace detail
+
+    SCN_END_NAMESPACE
+}  // namespace scn
+
+#if defined(SCN_HEADER_ONLY) && SCN_HEADER_ONLY && !defined(SCN_SIMD_CPP)
+#include "simd.cpp"
+#endif
+
+#endif  // SCN_DETAIL_SIMD_H
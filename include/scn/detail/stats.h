@@ -0,0 +1,131 @@
+// Copyright 2017 Elias Kosunen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// This file is a part of scnlib:
+//     https://github.com/eliaskosunen/scnlib
+
+#ifndef SCN_DETAIL_STATS_H
+#define SCN_DETAIL_STATS_H
+
+#include "fwd.h"
+
+#include <cstdint>
+
+#ifndef SCN_ENABLE_STATS
+#define SCN_ENABLE_STATS 0
+#endif
+
+namespace scn {
+    SCN_BEGIN_NAMESPACE
+
+    /**
+     * Counters collected while scanning, when the library is built with
+     * `SCN_ENABLE_STATS`.
+     *
+     * Counters are kept per thread, and are cumulative until
+     * `reset_scan_stats()` is called.
+     * Values from different threads can be combined with `operator+=`.
+     */
+    struct scan_stats {
+        /// Code units consumed from source ranges, including those later put
+        /// back or rolled back
+        std::uint64_t code_units_read{0};
+        /// Calls to `putback_n()`
+        std::uint64_t putback_calls{0};
+        /// Code units put back with `putback_n()`
+        std::uint64_t putback_code_units{0};
+        /// Calls to `reset_to_rollback_point()`
+        std::uint64_t rollbacks{0};
+        /// Code units rolled back with `reset_to_rollback_point()`
+        std::uint64_t rollback_code_units{0};
+        /// Code units skipped by `skip_range_whitespace()`
+        std::uint64_t whitespace_skipped{0};
+        /// Floating-point values parsed with `std::strtod` and friends
+        std::uint64_t strtod_fallbacks{0};
+        /// Floating-point values parsed with `std::from_chars`
+        std::uint64_t from_chars_fallbacks{0};
+        /// Numbers parsed through a custom (non-"C") locale
+        std::uint64_t localized_reads{0};
+        /// Heap allocations made for scanner temporaries
+        std::uint64_t scratch_allocations{0};
+
+        scan_stats& operator+=(const scan_stats& o) noexcept
+        {
+            code_units_read += o.code_units_read;
+            putback_calls += o.putback_calls;
+            putback_code_units += o.putback_code_units;
+            rollbacks += o.rollbacks;
+            rollback_code_units += o.rollback_code_units;
+            whitespace_skipped += o.whitespace_skipped;
+            strtod_fallbacks += o.strtod_fallbacks;
+            from_chars_fallbacks += o.from_chars_fallbacks;
+            localized_reads += o.localized_reads;
+            scratch_allocations += o.scratch_allocations;
+            return *this;
+        }
+        friend scan_stats operator+(scan_stats a, const scan_stats& b) noexcept
+        {
+            a += b;
+            return a;
+        }
+    };
+
+#if SCN_ENABLE_STATS
+    namespace detail {
+        inline scan_stats& thread_scan_stats() noexcept
+        {
+            static thread_local scan_stats s;
+            return s;
+        }
+    }  // namespace detail
+
+#define SCN_STATS_ADD(counter, n)                                  \
+    static_cast<void>(::scn::detail::thread_scan_stats().counter += \
+                      static_cast<std::uint64_t>(n))
+#define SCN_STATS_ONLY(...) __VA_ARGS__
+#else
+#define SCN_STATS_ADD(counter, n) static_cast<void>(0)
+#define SCN_STATS_ONLY(...)
+#endif
+
+    /**
+     * Returns the counters collected by the calling thread since it started,
+     * or since the last call to `reset_scan_stats()`.
+     *
+     * If the library was built without `SCN_ENABLE_STATS`, all counters are
+     * always zero.
+     */
+    inline scan_stats get_scan_stats() noexcept
+    {
+#if SCN_ENABLE_STATS
+        return detail::thread_scan_stats();
+#else
+        return {};
+#endif
+    }
+
+    /**
+     * Zeroes the counters of the calling thread.
+     */
+    inline void reset_scan_stats() noexcept
+    {
+#if SCN_ENABLE_STATS
+        detail::thread_scan_stats() = scan_stats{};
+#endif
+    }
+
+    SCN_END_NAMESPACE
+}  // namespace scn
+
+#endif  // SCN_DETAIL_STATS_H
@@ -0,0 +1,107 @@
+// Copyright 2017 Elias Kosunen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// This file is a part of scnlib:
+//     https://github.com/eliaskosunen/scnlib
+
+#ifndef SCN_DETAIL_TRACE_H
+#define SCN_DETAIL_TRACE_H
+
+#include "range.h"
+
+#ifndef SCN_USE_USDT
+#define SCN_USE_USDT 0
+#endif
+
+#if SCN_USE_USDT
+#include <sys/sdt.h>
+
+#define SCN_TRACE_PROBE1(name, a) DTRACE_PROBE1(scnlib, name, a)
+#define SCN_TRACE_PROBE2(name, a, b) DTRACE_PROBE2(scnlib, name, a, b)
+#define SCN_TRACE_PROBE3(name, a, b, c) DTRACE_PROBE3(scnlib, name, a, b, c)
+#else
+#define SCN_TRACE_PROBE1(name, a) static_cast<void>(0)
+#define SCN_TRACE_PROBE2(name, a, b) static_cast<void>(0)
+#define SCN_TRACE_PROBE3(name, a, b, c) static_cast<void>(0)
+#endif
+
+namespace scn {
+    SCN_BEGIN_NAMESPACE
+
+    namespace detail {
+#if SCN_USE_USDT
+        /**
+         * Fires the `scnlib:vscan__entry` and `scnlib:vscan__return` USDT
+         * probes around a `vscan` call.
+         *
+         * `vscan__entry` gets the kind of the source range (bit 0: contiguous,
+         * bit 1: direct), the size of its character type, and the length of
+         * the format string (0 for `scan_default`).
+         * `vscan__return` gets the error code, and the number of code units
+         * consumed, or -1 if the range isn't random-access.
+         */
+        template <typename WrappedRange>
+        class vscan_tracer {
+        public:
+            vscan_tracer(const WrappedRange& r, std::ptrdiff_t format_size)
+                : m_begin(r.begin())
+            {
+                SCN_TRACE_PROBE3(
+                    vscan__entry,
+                    (WrappedRange::is_contiguous ? 1 : 0) |
+                        (WrappedRange::is_direct ? 2 : 0),
+                    static_cast<int>(
+                        sizeof(typename WrappedRange::char_type)),
+                    format_size);
+            }
+
+            void done(const WrappedRange& r, const error& e)
+            {
+                SCN_TRACE_PROBE2(vscan__return, static_cast<int>(e.code()),
+                                 _consumed(r, priority_tag<1>{}));
+            }
+
+        private:
+            template <typename R = WrappedRange>
+            auto _consumed(const R& r, priority_tag<1>) const
+                -> decltype(r.begin() - r.begin(), std::ptrdiff_t{})
+            {
+                return static_cast<std::ptrdiff_t>(r.begin() - m_begin);
+            }
+            std::ptrdiff_t _consumed(const WrappedRange&, priority_tag<0>) const
+            {
+                return -1;
+            }
+
+            typename WrappedRange::iterator m_begin;
+        };
+#else
+        template <typename WrappedRange>
+        struct vscan_tracer {
+            constexpr vscan_tracer(const WrappedRange&, std::ptrdiff_t) noexcept
+            {
+            }
+
+            SCN_CONSTEXPR14 void done(const WrappedRange&,
+                                      const error&) noexcept
+            {
+            }
+        };
+#endif
+    }  // namespace detail
+
+    SCN_END_NAMESPACE
+}  // namespace scn
+
+#endif  // SCN_DETAIL_TRACE_H
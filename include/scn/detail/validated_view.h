@@ -0,0 +1,243 @@
+// Copyright 2017 Elias Kosunen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// This file is a part of scnlib:
+//     https://github.com/eliaskosunen/scnlib
+
+#ifndef SCN_DETAIL_VALIDATED_VIEW_H
+#define SCN_DETAIL_VALIDATED_VIEW_H
+
+#include "../unicode/unicode.h"
+#include "../util/expected.h"
+#include "../util/string_view.h"
+#include "simd.h"
+
+namespace scn {
+    SCN_BEGIN_NAMESPACE
+
+    /**
+     * A view over a string, which is known to contain validly encoded text:
+     * UTF-8 for `char`, and UTF-16 or UTF-32 for `wchar_t`.
+     * If `Ascii` is `true`, it's also known to contain only ASCII, so that
+     * every code unit is a code point of its own.
+     *
+     * When scanning from one of these, the code points read are not
+     * validated, and multibyte predicates (like localized whitespace) are
+     * evaluated one code unit at a time for ASCII input.
+     * If the contents are not actually valid, the behavior is undefined.
+     *
+     * Create one with `assume_valid_utf8()` or `ascii_only()`, or, to check
+     * the contents once beforehand, with `validate_utf8()` or
+     * `validate_ascii()`.
+     */
+    template <typename CharT, bool Ascii>
+    class basic_validated_view {
+    public:
+        using value_type = CharT;
+        using iterator = const CharT*;
+        using const_iterator = iterator;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+
+        static constexpr bool assume_valid_encoding = true;
+        static constexpr bool assume_ascii = Ascii;
+
+        constexpr basic_validated_view() noexcept = default;
+        constexpr basic_validated_view(const CharT* first,
+                                       const CharT* last) noexcept
+            : m_view(first, last)
+        {
+        }
+        constexpr basic_validated_view(const CharT* s, size_type n) noexcept
+            : m_view(s, n)
+        {
+        }
+        explicit constexpr basic_validated_view(
+            basic_string_view<CharT> sv) noexcept
+            : m_view(sv)
+        {
+        }
+
+        constexpr iterator begin() const noexcept
+        {
+            return m_view.data();
+        }
+        constexpr iterator end() const noexcept
+        {
+            return m_view.data() + m_view.size();
+        }
+        constexpr const CharT* data() const noexcept
+        {
+            return m_view.data();
+        }
+        constexpr size_type size() const noexcept
+        {
+            return m_view.size();
+        }
+        constexpr bool empty() const noexcept
+        {
+            return m_view.empty();
+        }
+
+        /// The contents as a plain `basic_string_view`
+        constexpr basic_string_view<CharT> view() const noexcept
+        {
+            return m_view;
+        }
+
+    private:
+        basic_string_view<CharT> m_view{};
+    };
+
+    template <typename CharT>
+    using basic_valid_utf8_view = basic_validated_view<CharT, false>;
+    template <typename CharT>
+    using basic_ascii_view = basic_validated_view<CharT, true>;
+
+    using valid_utf8_view = basic_valid_utf8_view<char>;
+    using ascii_view = basic_ascii_view<char>;
+
+    namespace detail {
+        template <typename Range>
+        using contiguous_char_t = typename std::remove_const<
+            typename std::remove_pointer<decltype(ranges::data(
+                SCN_DECLVAL(const Range&)))>::type>::type;
+
+        inline const char* find_invalid_encoding(const char* begin,
+                                                 const char* end)
+        {
+            return find_invalid_utf8(begin, end);
+        }
+        inline const wchar_t* find_invalid_encoding(const wchar_t* begin,
+                                                    const wchar_t* end)
+        {
+            while (begin != end) {
+                auto len = ::scn::get_sequence_length(*begin);
+                if (len == 0 || end - begin < len) {
+                    return begin;
+                }
+                code_point cp{};
+                auto ret = parse_code_point(begin, begin + len, cp);
+                if (!ret) {
+                    return begin;
+                }
+                begin = ret.value();
+            }
+            return end;
+        }
+
+        inline const char* find_non_ascii_unit(const char* begin,
+                                               const char* end)
+        {
+            return find_non_ascii(begin, end);
+        }
+        inline const wchar_t* find_non_ascii_unit(const wchar_t* begin,
+                                                  const wchar_t* end)
+        {
+            for (; begin != end; ++begin) {
+                if (static_cast<std::make_unsigned<wchar_t>::type>(*begin) >=
+                    0x80) {
+                    break;
+                }
+            }
+            return begin;
+        }
+    }  // namespace detail
+
+    /// @{
+    /**
+     * Marks the contiguous range `r` (a string, a string view, or a mapped
+     * file) as validly encoded, without checking it.
+     *
+     * \see basic_validated_view
+     */
+    template <typename Range,
+              typename CharT = detail::contiguous_char_t<Range>>
+    basic_valid_utf8_view<CharT> assume_valid_utf8(const Range& r)
+    {
+        return {ranges::data(r), static_cast<size_t>(ranges::size(r))};
+    }
+    template <typename CharT, size_t N>
+    basic_valid_utf8_view<CharT> assume_valid_utf8(const CharT (&str)[N])
+    {
+        return {str, N - 1};
+    }
+    /// @}
+
+    /// @{
+    /**
+     * Marks the contiguous range `r` as containing only ASCII, without
+     * checking it.
+     *
+     * \see basic_validated_view
+     */
+    template <typename Range,
+              typename CharT = detail::contiguous_char_t<Range>>
+    basic_ascii_view<CharT> ascii_only(const Range& r)
+    {
+        return {ranges::data(r), static_cast<size_t>(ranges::size(r))};
+    }
+    template <typename CharT, size_t N>
+    basic_ascii_view<CharT> ascii_only(const CharT (&str)[N])
+    {
+        return {str, N - 1};
+    }
+    /// @}
+
+    /**
+     * Checks, that the contiguous range `r` is validly encoded, and returns
+     * a view to it, which can be scanned without further validation.
+     *
+     * For `char`, runs of ASCII are skipped with the vectorized kernels in
+     * `simd.h`, so that checking mostly-ASCII input is close to `memchr`
+     * speed.
+     *
+     * \return `error::invalid_encoding`, if `r` contains an invalid, overlong
+     * or truncated sequence, or an encoded surrogate.
+     */
+    template <typename Range,
+              typename CharT = detail::contiguous_char_t<Range>>
+    expected<basic_valid_utf8_view<CharT>> validate_utf8(const Range& r)
+    {
+        auto view = assume_valid_utf8(r);
+        auto end = view.data() + view.size();
+        if (detail::find_invalid_encoding(view.data(), end) != end) {
+            return error(error::invalid_encoding, "Invalid encoding");
+        }
+        return {view};
+    }
+
+    /**
+     * Checks, that the contiguous range `r` only contains ASCII, and returns
+     * a view to it.
+     *
+     * \return `error::invalid_encoding`, if `r` contains code units
+     * outside of ASCII.
+     */
+    template <typename Range,
+              typename CharT = detail::contiguous_char_t<Range>>
+    expected<basic_ascii_view<CharT>> validate_ascii(const Range& r)
+    {
+        auto view = ascii_only(r);
+        auto end = view.data() + view.size();
+        if (detail::find_non_ascii_unit(view.data(), end) != end) {
+            return error(error::invalid_encoding, "Non-ASCII code unit");
+        }
+        return {view};
+    }
+
+    SCN_END_NAMESPACE
+}  // namespace scn
+
+#endif  // SCN_DETAIL_VALIDATED_VIEW_H
@@ -19,6 +19,7 @@
 #define SCN_DETAIL_VISITOR_H
 
 #include "../reader/reader.h"
+#include "trace.h"
 
 namespace scn {
     SCN_BEGIN_NAMESPACE
@@ -115,131 +116,192 @@ namespace scn {
         ParseCtx* m_pctx;
     };
 
-    template <typename Context, typename ParseCtx>
-    error visit(Context& ctx,
-                ParseCtx& pctx,
-                basic_args<typename Context::char_type> args)
-    {
-        using char_type = typename Context::char_type;
-        using arg_type = basic_arg<char_type>;
-        auto arg = arg_type{};
-
-        while (pctx) {
-            if (pctx.should_skip_ws()) {
-                // Skip whitespace from format string and from stream
-                // EOF is not an error
-                auto ret = skip_range_whitespace(ctx, false);
-                if (SCN_UNLIKELY(!ret)) {
-                    if (ret == error::end_of_range) {
-                        break;
-                    }
-                    SCN_CLANG_PUSH_IGNORE_UNDEFINED_TEMPLATE
-                    auto rb = ctx.range().reset_to_rollback_point();
-                    if (!rb) {
-                        return rb;
+    namespace detail {
+        /**
+         * Walks the format string in `pctx`, skipping whitespace and matching
+         * literal characters against the source range in `ctx`.
+         *
+         * For every replacement field, the index of the argument to read is
+         * resolved, and passed to `get_arg(id)`, which returns an
+         * `expected` containing a handle to the argument. This handle is
+         * then given to `scan_arg(a)`, which reads it using `pctx`.
+         *
+         * This is the loop behind `visit()`, factored out so that it can be
+         * reused with arguments that aren't type-erased, see `scan_columns`.
+         */
+        template <typename Context,
+                  typename ParseCtx,
+                  typename ArgGetter,
+                  typename ArgScanner>
+        error visit_format(Context& ctx,
+                           ParseCtx& pctx,
+                           ArgGetter&& get_arg,
+                           ArgScanner&& scan_arg)
+        {
+            while (pctx) {
+                if (pctx.should_skip_ws()) {
+                    // Skip whitespace from format string and from stream
+                    // EOF is not an error
+                    auto ret = skip_range_whitespace(ctx, false);
+                    if (SCN_UNLIKELY(!ret)) {
+                        if (ret == error::end_of_range) {
+                            break;
+                        }
+                        SCN_CLANG_PUSH_IGNORE_UNDEFINED_TEMPLATE
+                        auto rb = ctx.range().reset_to_rollback_point();
+                        if (!rb) {
+                            return rb;
+                        }
+                        return ret;
                     }
-                    return ret;
+                    // Don't advance pctx, should_skip_ws() does it for us
+                    continue;
                 }
-                // Don't advance pctx, should_skip_ws() does it for us
-                continue;
-            }
 
-            // Non-brace character, or
-            // Brace followed by another brace, meaning a literal '{'
-            if (pctx.should_read_literal()) {
-                if (SCN_UNLIKELY(!pctx)) {
-                    return {error::invalid_format_string,
-                            "Unexpected end of format string"};
-                }
-                // Check for any non-specifier {foo} characters
-                alignas(typename Context::char_type) unsigned char buf[4] = {0};
-                auto ret = read_code_point(ctx.range(), make_span(buf, 4));
-                SCN_CLANG_POP_IGNORE_UNDEFINED_TEMPLATE
-                if (!ret || !pctx.check_literal(ret.value().chars)) {
-                    auto rb = ctx.range().reset_to_rollback_point();
-                    if (!rb) {
-                        // Failed rollback
-                        return rb;
+                // Non-brace character, or
+                // Brace followed by another brace, meaning a literal '{'
+                if (pctx.should_read_literal()) {
+                    if (SCN_UNLIKELY(!pctx)) {
+                        return {error::invalid_format_string,
+                                "Unexpected end of format string"};
                     }
-                    if (!ret) {
-                        // Failed read
-                        return ret.error();
+                    // Match as much of the literal as possible at once
+                    auto matched =
+                        match_literal(ctx.range(), pctx.literal_run());
+                    if (!matched) {
+                        auto rb = ctx.range().reset_to_rollback_point();
+                        if (!rb) {
+                            return rb;
+                        }
+                        return matched.error();
+                    }
+                    if (matched.value() != 0) {
+                        pctx.advance_char(
+                            static_cast<std::ptrdiff_t>(matched.value()));
+                        continue;
                     }
 
-                    // Mismatching characters in scan string and stream
-                    return {error::invalid_scanned_value,
-                            "Expected character from format string not "
-                            "found in the stream"};
-                }
-                // Bump pctx to next char
-                if (!pctx.advance_cp()) {
-                    pctx.advance_char();
-                }
-            }
-            else {
-                // Scan argument
-                auto arg_wrapped = [&]() -> expected<arg_type> {
-                    if (!pctx.has_arg_id()) {
-                        return next_arg(args, pctx);
+                    // Check for any non-specifier {foo} characters
+                    alignas(typename Context::char_type) unsigned char
+                        buf[4] = {0};
+                    auto ret = read_code_point(ctx.range(), make_span(buf, 4));
+                    SCN_CLANG_POP_IGNORE_UNDEFINED_TEMPLATE
+                    if (!ret || !pctx.check_literal(ret.value().chars)) {
+                        auto rb = ctx.range().reset_to_rollback_point();
+                        if (!rb) {
+                            // Failed rollback
+                            return rb;
+                        }
+                        if (!ret) {
+                            // Failed read
+                            return ret.error();
+                        }
+
+                        // Mismatching characters in scan string and stream
+                        return {error::invalid_scanned_value,
+                                "Expected character from format string not "
+                                "found in the stream"};
                     }
-                    auto id_wrapped = pctx.parse_arg_id();
+                    // Bump pctx to next char
+                    if (!pctx.advance_cp()) {
+                        pctx.advance_char();
+                    }
+                }
+                else {
+                    // Scan argument
+                    auto id_wrapped = [&]() -> expected<std::ptrdiff_t> {
+                        if (!pctx.has_arg_id()) {
+                            return pctx.next_arg_id();
+                        }
+                        auto arg_id = pctx.parse_arg_id();
+                        if (!arg_id) {
+                            return arg_id.error();
+                        }
+                        auto id = arg_id.value();
+                        SCN_ENSURE(!id.empty());
+                        if (ctx.locale().get_static().is_digit(id.front())) {
+                            auto s = simple_integer_scanner<std::ptrdiff_t>{};
+                            std::ptrdiff_t i{0};
+                            auto span = make_span(id.data(), id.size());
+                            SCN_CLANG_PUSH_IGNORE_UNDEFINED_TEMPLATE
+                            auto ret = s.scan(span, i, 10);
+                            SCN_CLANG_POP_IGNORE_UNDEFINED_TEMPLATE
+                            if (!ret || ret.value() != span.end()) {
+                                return error(error::invalid_format_string,
+                                             "Failed to parse argument id "
+                                             "from format string");
+                            }
+                            if (!pctx.check_arg_id(i)) {
+                                return error(error::invalid_format_string,
+                                             "Argument id out of range");
+                            }
+                            return i;
+                        }
+                        // Named arguments are not supported
+                        return error(error::invalid_format_string,
+                                     "Argument id out of range");
+                    }();
                     if (!id_wrapped) {
                         return id_wrapped.error();
                     }
-                    auto id = id_wrapped.value();
-                    SCN_ENSURE(!id.empty());
-                    if (ctx.locale().get_static().is_digit(id.front())) {
-                        auto s =
-                            detail::simple_integer_scanner<std::ptrdiff_t>{};
-                        std::ptrdiff_t i{0};
-                        auto span = make_span(id.data(), id.size());
-                        SCN_CLANG_PUSH_IGNORE_UNDEFINED_TEMPLATE
-                        auto ret = s.scan(span, i, 10);
-                        SCN_CLANG_POP_IGNORE_UNDEFINED_TEMPLATE
-                        if (!ret || ret.value() != span.end()) {
-                            return error(error::invalid_format_string,
-                                         "Failed to parse argument id from "
-                                         "format string");
-                        }
-                        return get_arg(args, pctx, i);
+                    auto arg = get_arg(id_wrapped.value());
+                    if (!arg) {
+                        return arg.error();
                     }
-                    return get_arg(args, pctx, id);
-                }();
-                if (!arg_wrapped) {
-                    return arg_wrapped.error();
-                }
-                arg = arg_wrapped.value();
-                SCN_ENSURE(arg);
-                if (!pctx) {
-                    return {error::invalid_format_string,
-                            "Unexpected end of format argument"};
-                }
-                auto ret = visit_arg<char_type>(
-                    basic_visitor<Context, ParseCtx>(ctx, pctx), arg);
-                if (!ret) {
-                    auto rb = ctx.range().reset_to_rollback_point();
-                    if (!rb) {
-                        return rb;
+                    if (!pctx) {
+                        return {error::invalid_format_string,
+                                "Unexpected end of format argument"};
                     }
-                    return ret;
-                }
-                // Handle next arg and bump pctx
-                pctx.arg_handled();
-                if (pctx) {
-                    auto e = pctx.advance_cp();
-                    if (!e) {
-                        return e;
+                    auto ret = scan_arg(arg.value());
+                    if (!ret) {
+                        auto rb = ctx.range().reset_to_rollback_point();
+                        if (!rb) {
+                            return rb;
+                        }
+                        return ret;
+                    }
+                    // Handle next arg and bump pctx
+                    pctx.arg_handled();
+                    if (pctx) {
+                        auto e = pctx.advance_cp();
+                        if (!e) {
+                            return e;
+                        }
                     }
                 }
             }
+            if (pctx) {
+                // Format string not exhausted
+                return {error::invalid_format_string,
+                        "Format string not exhausted"};
+            }
+            ctx.range().set_rollback_point();
+            return {};
         }
-        if (pctx) {
-            // Format string not exhausted
-            return {error::invalid_format_string,
-                    "Format string not exhausted"};
-        }
-        ctx.range().set_rollback_point();
-        return {};
+    }  // namespace detail
+
+    template <typename Context, typename ParseCtx>
+    error visit(Context& ctx,
+                ParseCtx& pctx,
+                basic_args<typename Context::char_type> args)
+    {
+        using char_type = typename Context::char_type;
+        using arg_type = basic_arg<char_type>;
+
+        return detail::visit_format(
+            ctx, pctx,
+            [&](std::ptrdiff_t id) -> expected<arg_type> {
+                return get_arg(args, id);
+            },
+            [&](arg_type arg) -> error {
+                SCN_ENSURE(arg);
+                SCN_TRACE_PROBE1(arg__entry, static_cast<int>(arg.type()));
+                auto e = visit_arg<char_type>(
+                    basic_visitor<Context, ParseCtx>(ctx, pctx), arg);
+                SCN_TRACE_PROBE2(arg__return, static_cast<int>(arg.type()),
+                                 static_cast<int>(e.code()));
+                return e;
+            });
     }
 
     SCN_END_NAMESPACE
@@ -59,6 +59,9 @@ namespace std::ranges {
     inline constexpr bool enable_view<::scn::basic_string_view<CharT>> = true;
     template <typename T>
     inline constexpr bool enable_view<::scn::span<T>> = true;
+    template <typename CharT, bool Ascii>
+    inline constexpr bool
+        enable_view<::scn::basic_validated_view<CharT, Ascii>> = true;
 }  // namespace std
 
 #define SCN_CHECK_CONCEPT(C) C
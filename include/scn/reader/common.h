@@ -21,9 +21,12 @@
 #include "../detail/error.h"
 #include "../detail/locale.h"
 #include "../detail/range.h"
+#include "../detail/simd.h"
 #include "../unicode/unicode.h"
 #include "../util/algorithm.h"
 
+#include <cstring>
+
 namespace scn {
     SCN_BEGIN_NAMESPACE
 
@@ -114,6 +117,8 @@ namespace scn {
     error putback_n(WrappedRange& r, ranges::range_difference_t<WrappedRange> n)
     {
         SCN_EXPECT(n <= ranges::distance(r.begin_underlying(), r.begin()));
+        SCN_STATS_ADD(putback_calls, 1);
+        SCN_STATS_ADD(putback_code_units, n);
         r.advance(-n);
         return {};
     }
@@ -122,6 +127,8 @@ namespace scn {
         typename std::enable_if<!WrappedRange::is_contiguous>::type* = nullptr>
     error putback_n(WrappedRange& r, ranges::range_difference_t<WrappedRange> n)
     {
+        SCN_STATS_ADD(putback_calls, 1);
+        SCN_STATS_ADD(putback_code_units, n);
         for (ranges::range_difference_t<WrappedRange> i = 0; i < n; ++i) {
             r.advance(-1);
             if (r.begin() == r.end()) {
@@ -168,7 +175,9 @@ namespace scn {
                 sbuf = writebuf.first(1);
                 writebuf[0] = ret.value();
             }
-            int len = ::scn::get_sequence_length(sbuf[0]);
+            int len = WrappedRange::assume_ascii
+                          ? 1
+                          : ::scn::get_sequence_length(sbuf[0]);
             if (SCN_UNLIKELY(len == 0)) {
                 return error(error::invalid_encoding, "Invalid code point");
             }
@@ -319,6 +328,84 @@ namespace scn {
         SCN_GCC_POP
     }
 
+    // match_literal
+
+    /// @{
+
+    /**
+     * Reads the code units in `lit` from `r`, if they're equal to the code
+     * units at the beginning of `r`. Instead of reading one code point at a
+     * time, `lit` is compared against the buffer of `r` with a single
+     * `memcmp`.
+     *
+     * Only a part of `lit` is matched, if the buffer of `r` ends before
+     * it. In that case, the part matched ends at a code point boundary.
+     *
+     * \return The number of code units of `lit` read from `r`. If they
+     * weren't equal, `r` is left untouched, and `0` is returned. `0` is also
+     * returned, if `r` doesn't provide buffer access, or if it's at the end
+     * of its buffer: `read_code_point()` should then be used to read the
+     * next code point of `lit`.
+     * If `putback_n()` fails, returns any errors returned by it.
+     */
+    template <typename WrappedRange,
+              typename std::enable_if<
+                  WrappedRange::provides_buffer_access>::type* = nullptr>
+    expected<std::size_t> match_literal(
+        WrappedRange& r,
+        span<const typename WrappedRange::char_type> lit)
+    {
+        using char_type = typename WrappedRange::char_type;
+
+        if (lit.size() == 0 || r.begin() == r.end()) {
+            return {std::size_t{0}};
+        }
+        auto buf = r.get_buffer_and_advance(lit.size());
+        if (buf.size() == 0) {
+            return {std::size_t{0}};
+        }
+        if (std::memcmp(buf.data(), lit.data(),
+                        buf.size() * sizeof(char_type)) != 0) {
+            auto e = putback_n(r, buf.ssize());
+            if (!e) {
+                return e;
+            }
+            return {std::size_t{0}};
+        }
+        if (buf.size() == lit.size()) {
+            return {buf.size()};
+        }
+
+        // Don't stop in the middle of a code point
+        std::size_t n = 0;
+        while (n < buf.size()) {
+            const auto len = static_cast<std::size_t>(
+                ::scn::get_sequence_length(lit[n]));
+            if (len == 0 || n + len > buf.size()) {
+                break;
+            }
+            n += len;
+        }
+        if (n != buf.size()) {
+            auto e = putback_n(r, static_cast<std::ptrdiff_t>(buf.size() - n));
+            if (!e) {
+                return e;
+            }
+        }
+        return {n};
+    }
+    template <typename WrappedRange,
+              typename std::enable_if<
+                  !WrappedRange::provides_buffer_access>::type* = nullptr>
+    expected<std::size_t> match_literal(
+        WrappedRange&,
+        span<const typename WrappedRange::char_type>)
+    {
+        return {std::size_t{0}};
+    }
+
+    /// @}
+
     // read_zero_copy
 
     /// @{
@@ -496,6 +583,34 @@ namespace scn {
     /// @}
 
     namespace detail {
+        /**
+         * If `pred` has a member function `find(begin, end, stop)`, uses it
+         * to find the first code unit in `[begin, end)` for which `pred`
+         * would return `stop`. `find` returns `nullptr`, if it can't be used
+         * in the current configuration (localized, width-limited).
+         *
+         * Otherwise, returns `nullptr`.
+         */
+        template <typename Predicate, typename CharT>
+        auto pred_find_contiguous(Predicate& pred,
+                                  const CharT* begin,
+                                  const CharT* end,
+                                  bool stop,
+                                  priority_tag<1>)
+            -> decltype(pred.find(begin, end, stop))
+        {
+            return pred.find(begin, end, stop);
+        }
+        template <typename Predicate, typename CharT>
+        const CharT* pred_find_contiguous(Predicate&,
+                                          const CharT*,
+                                          const CharT*,
+                                          bool,
+                                          priority_tag<0>)
+        {
+            return nullptr;
+        }
+
         template <typename WrappedRange, typename Predicate>
         expected<span<const typename WrappedRange::char_type>>
         read_until_pred_contiguous(WrappedRange& r,
@@ -509,7 +624,24 @@ namespace scn {
                 return error(error::end_of_range, "EOF");
             }
 
-            if (!pred.is_multibyte()) {
+            // With ASCII-only input, every code point is a single code unit
+            if (!pred.is_multibyte() || WrappedRange::assume_ascii) {
+                auto found = pred_find_contiguous(pred, r.data(),
+                                                  r.data() + r.size(),
+                                                  pred_result_to_stop,
+                                                  priority_tag<1>{});
+                if (found) {
+                    auto begin = r.data();
+                    auto last = r.data() + r.size();
+                    if (found == last) {
+                        r.advance_to(r.end());
+                        return span_type{begin, last};
+                    }
+                    auto n = found - begin;
+                    auto end = r.begin() + (keep_final ? n + 1 : n);
+                    r.advance_to(end);
+                    return span_type{begin, found + (keep_final ? 1 : 0)};
+                }
                 for (auto it = r.begin(); it != r.end(); ++it) {
                     if (pred(make_span(&*it, 1)) == pred_result_to_stop) {
                         auto begin = r.data();
@@ -523,21 +655,24 @@ namespace scn {
             else {
                 for (auto it = r.begin(); it != r.end();) {
                     auto len = ::scn::get_sequence_length(*it);
-                    if (len == 0 || ranges::distance(it, r.end()) < len) {
-                        return error{error::invalid_encoding,
-                                     "Invalid code point"};
-                    }
                     auto span =
                         make_span(to_address_safe(it, r.begin(), r.end()),
                                   static_cast<size_t>(len));
-                    code_point cp{};
-                    auto i = parse_code_point(span.begin(), span.end(), cp);
-                    if (!i) {
-                        return i.error();
-                    }
-                    if (i.value() != span.end()) {
-                        return error{error::invalid_encoding,
-                                     "Invalid code point"};
+                    if (!WrappedRange::assume_valid_encoding) {
+                        if (len == 0 || ranges::distance(it, r.end()) < len) {
+                            return error{error::invalid_encoding,
+                                         "Invalid code point"};
+                        }
+                        code_point cp{};
+                        auto i =
+                            parse_code_point(span.begin(), span.end(), cp);
+                        if (!i) {
+                            return i.error();
+                        }
+                        if (i.value() != span.end()) {
+                            return error{error::invalid_encoding,
+                                         "Invalid code point"};
+                        }
                     }
                     if (pred(span) == pred_result_to_stop) {
                         auto begin = r.data();
@@ -641,12 +776,13 @@ namespace scn {
             if (!pred.is_multibyte()) {
                 while (r.begin() != r.end() && !done) {
                     auto s = r.get_buffer_and_advance();
-                    for (auto it = s.begin(); it != s.end() && out_cmp(out);
-                         ++it) {
+                    auto it = s.begin();
+                    for (; it != s.end() && out_cmp(out); ++it) {
                         if (pred(make_span(&*it, 1)) == pred_result_to_stop) {
                             if (keep_final) {
                                 *out = *it;
                                 ++out;
+                                ++it;
                             }
                             auto e =
                                 putback_n(r, ranges::distance(it, s.end()));
@@ -659,7 +795,12 @@ namespace scn {
                         *out = *it;
                         ++out;
                     }
-                    if (!done && out_cmp(out)) {
+                    if (!done && !out_cmp(out)) {
+                        // `out` is full, give back what wasn't read
+                        done = true;
+                        return putback_n(r, ranges::distance(it, s.end()));
+                    }
+                    if (!done) {
                         auto ret = read_code_unit(r, false);
                         if (!ret) {
                             if (ret.error() == error::end_of_range) {
@@ -1002,7 +1143,39 @@ namespace scn {
                 return is_localized() && is_multichar_type(CharT{});
             }
 
+            /**
+             * Returns a pointer to the first code unit in `[begin, end)`
+             * that is (`stop == true`) or isn't (`stop == false`) a space,
+             * using the vectorized kernels in `simd.h`.
+             *
+             * Only available for `char`, when not localized and without a
+             * maximum width: otherwise, returns `nullptr`.
+             */
+            const char_type* find(const char_type* begin,
+                                  const char_type* end,
+                                  bool stop) const
+            {
+                if (is_localized() || m_width != 0) {
+                    return nullptr;
+                }
+                return find_classic(begin, end, stop);
+            }
+
         private:
+            static const char* find_classic(const char* begin,
+                                            const char* end,
+                                            bool stop)
+            {
+                return stop ? find_classic_space(begin, end)
+                            : find_classic_nonspace(begin, end);
+            }
+            static const wchar_t* find_classic(const wchar_t*,
+                                               const wchar_t*,
+                                               bool)
+            {
+                return nullptr;
+            }
+
             using static_locale_type = typename locale_type::static_type;
             using custom_locale_type = typename locale_type::custom_type;
             const custom_locale_type* m_locale;
@@ -1021,7 +1194,7 @@ namespace scn {
                                        size_t)
             {
                 SCN_EXPECT(locale != nullptr);
-                return locale->is_space(ch);
+                return (locale->classify(ch) & ctype_class::space) != 0;
             }
             SCN_CONSTEXPR14 static bool call_counting(const custom_locale_type*,
                                                       span<const char_type> ch,
@@ -1047,7 +1220,7 @@ namespace scn {
                     return true;
                 }
                 i += ch.size();
-                return locale->is_space(ch);
+                return (locale->classify(ch) & ctype_class::space) != 0;
             }
 
             using fn_type = bool (*)(const custom_locale_type*,
@@ -1134,9 +1307,13 @@ namespace scn {
         auto is_space_pred =
             detail::make_is_space_predicate(ctx.locale(), localized);
         auto it = detail::basic_skipws_iterator<typename Context::char_type>{};
-        return detail::read_until_pred_non_contiguous(
+        SCN_STATS_ONLY(const auto stats_begin = ctx.range().begin();)
+        auto e = detail::read_until_pred_non_contiguous(
             ctx.range(), is_space_pred, false, it,
             [](decltype(it)) { return true; }, false);
+        SCN_STATS_ADD(whitespace_skipped,
+                      ranges::distance(stats_begin, ctx.range().begin()));
+        return e;
     }
     template <typename Context,
               typename std::enable_if<
@@ -1145,9 +1322,13 @@ namespace scn {
     {
         auto is_space_pred =
             detail::make_is_space_predicate(ctx.locale(), localized);
-        return detail::read_until_pred_contiguous(ctx.range(), is_space_pred,
-                                                  false, false)
-            .error();
+        SCN_STATS_ONLY(const auto stats_begin = ctx.range().begin();)
+        auto e = detail::read_until_pred_contiguous(ctx.range(), is_space_pred,
+                                                    false, false)
+                     .error();
+        SCN_STATS_ADD(whitespace_skipped,
+                      ranges::distance(stats_begin, ctx.range().begin()));
+        return e;
     }
 
     /// @}
@@ -1620,33 +1801,24 @@ namespace scn {
         }
 
         /**
-         * Scan argument in `val`, from `ctx`, using `Scanner` and `pctx`.
+         * Scan argument in `val`, from `ctx`, using an already parsed
+         * `scanner`.
          *
-         * Parses `pctx` for `Scanner`, skips whitespace and alignment if
-         * necessary, and scans the argument into `val`.
+         * Skips whitespace and alignment if necessary, and scans the argument
+         * into `val`.
          */
-        template <typename Scanner,
-                  typename T,
-                  typename Context,
-                  typename ParseCtx>
-        error visitor_boilerplate(T& val, Context& ctx, ParseCtx& pctx)
+        template <typename Scanner, typename T, typename Context>
+        error scan_with_parsed_scanner(Scanner& scanner, T& val, Context& ctx)
         {
-            Scanner scanner;
-
-            auto err = pctx.parse(scanner);
-            if (!err) {
-                return err;
-            }
-
             if (scanner.skip_preceding_whitespace()) {
-                err = skip_range_whitespace(ctx, false);
+                auto err = skip_range_whitespace(ctx, false);
                 if (!err) {
                     return err;
                 }
             }
 
-            err = skip_alignment(ctx, scanner, false,
-                                 scanner_supports_alignment<Scanner>{});
+            auto err = skip_alignment(ctx, scanner, false,
+                                      scanner_supports_alignment<Scanner>{});
             if (!err) {
                 return err;
             }
@@ -1659,6 +1831,63 @@ namespace scn {
             return skip_alignment(ctx, scanner, true,
                                   scanner_supports_alignment<Scanner>{});
         }
+
+        /**
+         * Scan argument in `val`, from `ctx`, using a `scanner` that is parsed
+         * once, and then reused for every value.
+         *
+         * Scanners with a `const` `scan()`, like the built-in ones, are used
+         * as is. Other scanners are copied first, so that the state they
+         * change in `scan()` doesn't carry over to the next value.
+         */
+        template <typename Scanner, typename T, typename Context>
+        auto scan_with_configured_scanner(const Scanner& scanner,
+                                          T& val,
+                                          Context& ctx,
+                                          priority_tag<1>)
+            -> decltype(scanner.scan(val, ctx))
+        {
+            return scan_with_parsed_scanner(scanner, val, ctx);
+        }
+        template <typename Scanner, typename T, typename Context>
+        error scan_with_configured_scanner(const Scanner& scanner,
+                                           T& val,
+                                           Context& ctx,
+                                           priority_tag<0>)
+        {
+            auto s = scanner;
+            return scan_with_parsed_scanner(s, val, ctx);
+        }
+        template <typename Scanner, typename T, typename Context>
+        error scan_with_configured_scanner(const Scanner& scanner,
+                                           T& val,
+                                           Context& ctx)
+        {
+            return scan_with_configured_scanner(scanner, val, ctx,
+                                                priority_tag<1>{});
+        }
+
+        /**
+         * Scan argument in `val`, from `ctx`, using `Scanner` and `pctx`.
+         *
+         * Parses `pctx` for `Scanner`, and then calls
+         * `scan_with_parsed_scanner`.
+         */
+        template <typename Scanner,
+                  typename T,
+                  typename Context,
+                  typename ParseCtx>
+        error visitor_boilerplate(T& val, Context& ctx, ParseCtx& pctx)
+        {
+            Scanner scanner;
+
+            auto err = pctx.parse(scanner);
+            if (!err) {
+                return err;
+            }
+
+            return scan_with_parsed_scanner(scanner, val, ctx);
+        }
     }  // namespace detail
 
     SCN_END_NAMESPACE
@@ -18,15 +18,13 @@
 #ifndef SCN_READER_FLOAT_H
 #define SCN_READER_FLOAT_H
 
+#include "../util/scratch_buffer.h"
 #include "../util/small_vector.h"
 #include "common.h"
 
 namespace scn {
     SCN_BEGIN_NAMESPACE
     namespace detail {
-        template <typename T>
-        struct float_scanner_access;
-
         template <typename T>
         struct float_scanner : common_parser {
             static_assert(std::is_floating_point<T>::value,
@@ -124,7 +122,7 @@ namespace scn {
             }
 
             template <typename Context>
-            error scan(T& val, Context& ctx)
+            error scan(T& val, Context& ctx) const
             {
                 using char_type = typename Context::char_type;
 
@@ -146,9 +144,10 @@ namespace scn {
                         // and custom (localized) decimal points,
                         // so we have to fall back on iostreams
                         SCN_CLANG_PUSH_IGNORE_UNDEFINED_TEMPLATE
-                        std::basic_string<char_type> str(s.data(), s.size());
-                        ret =
-                            ctx.locale().get_localized().read_num(tmp, str, 0);
+                        scratch_string<char_type> str{};
+                        str.get().assign(s.data(), s.size());
+                        ret = ctx.locale().get_localized().read_num(
+                            tmp, str.get(), 0);
                         SCN_CLANG_POP_IGNORE_UNDEFINED_TEMPLATE
                     }
                     else {
@@ -209,15 +208,18 @@ namespace scn {
 
         private:
             template <typename CharT>
-            expected<std::ptrdiff_t> _read_float(T& val,
-                                                 span<const CharT> s,
-                                                 CharT locale_decimal_point)
+            expected<std::ptrdiff_t> _read_float(
+                T& val,
+                span<const CharT> s,
+                CharT locale_decimal_point) const
             {
                 size_t chars{};
-                std::basic_string<CharT> str(s.data(), s.size());
+                // Copied to get a null terminator
+                scratch_string<CharT> str{};
+                str.get().assign(s.data(), s.size());
                 SCN_CLANG_PUSH_IGNORE_UNDEFINED_TEMPLATE
-                auto ret =
-                    _read_float_impl(str.data(), chars, locale_decimal_point);
+                auto ret = _read_float_impl(str.get().c_str(), chars,
+                                            locale_decimal_point);
                 SCN_CLANG_POP_IGNORE_UNDEFINED_TEMPLATE
                 if (!ret) {
                     return ret.error();
@@ -229,7 +231,7 @@ namespace scn {
             template <typename CharT>
             expected<T> _read_float_impl(const CharT* str,
                                          size_t& chars,
-                                         CharT locale_decimal_point);
+                                         CharT locale_decimal_point) const;
         };
 
         // instantiate
@@ -19,6 +19,7 @@
 #define SCN_READER_INT_H
 
 #include "../util/math.h"
+#include "../util/scratch_buffer.h"
 #include "common.h"
 
 namespace scn {
@@ -32,7 +33,7 @@ namespace scn {
 
             friend struct simple_integer_scanner<T>;
 
-            bool skip_preceding_whitespace()
+            bool skip_preceding_whitespace() const
             {
                 // if format_options == single_code_unit,
                 // then we're scanning a char -> don't skip
@@ -225,7 +226,7 @@ namespace scn {
             }
 
             template <typename Context>
-            error scan(T& val, Context& ctx)
+            error scan(T& val, Context& ctx) const
             {
                 using char_type = typename Context::char_type;
                 auto do_parse_int = [&](span<const char_type> s) -> error {
@@ -249,20 +250,20 @@ namespace scn {
                             return {error::invalid_scanned_value,
                                     "Invalid base prefix"};
                         }
-                        if (base == 0) {
-                            base = static_cast<uint8_t>(b);
-                        }
-                        if (base != 8 && base != 10 && base != 16) {
+                        // The detected base is only used for this value
+                        const int value_base = base == 0 ? b : base;
+                        if (value_base != 8 && value_base != 10 &&
+                            value_base != 16) {
                             return {error::invalid_scanned_value,
                                     "Localized values have to be in base "
                                     "8, 10 or 16"};
                         }
 
                         auto it = r.value();
-                        std::basic_string<char_type> str(to_address(it),
-                                                         s.size());
+                        scratch_string<char_type> str{};
+                        str.get().assign(to_address(it), s.size());
                         ret = ctx.locale().get_localized().read_num(
-                            tmp, str, static_cast<int>(base));
+                            tmp, str.get(), value_base);
 
                         if (tmp < T{0} &&
                             (format_options & only_unsigned) != 0) {
@@ -327,10 +328,10 @@ namespace scn {
                 }
                 SCN_MSVC_POP
 
-                std::basic_string<char_type> buf{};
+                scratch_string<char_type> buf{};
                 span<const char_type> bufspan{};
                 auto e = _read_source(
-                    ctx, buf, bufspan,
+                    ctx, buf.get(), bufspan,
                     std::integral_constant<
                         bool, Context::range_type::is_contiguous>{});
                 if (!e) {
@@ -376,7 +377,7 @@ namespace scn {
             error _read_source(Context& ctx,
                                Buf& buf,
                                span<const CharT>& s,
-                               std::false_type)
+                               std::false_type) const
             {
                 auto do_read = [&](Buf& b) -> error {
                     auto outputit = std::back_inserter(b);
@@ -401,8 +402,7 @@ namespace scn {
                     return {};
                 }
 
-                Buf tmp;
-                auto e = do_read(tmp);
+                auto e = do_read(buf);
                 if (!e) {
                     return e;
                 }
@@ -414,10 +414,10 @@ namespace scn {
 #endif
                                  .thousands_separator();
 
-                auto it = tmp.begin();
-                for (; it != tmp.end(); ++it) {
+                auto it = buf.begin();
+                for (; it != buf.end(); ++it) {
                     if (*it == thsep) {
-                        for (auto it2 = it; ++it2 != tmp.end();) {
+                        for (auto it2 = it; ++it2 != buf.end();) {
                             *it++ = SCN_MOVE(*it2);
                         }
                         break;
@@ -425,13 +425,12 @@ namespace scn {
                 }
 
                 auto n =
-                    static_cast<std::size_t>(std::distance(tmp.begin(), it));
+                    static_cast<std::size_t>(std::distance(buf.begin(), it));
                 if (n == 0) {
                     return {error::invalid_scanned_value,
                             "Only a thousands separator found"};
                 }
 
-                buf = SCN_MOVE(tmp);
                 s = make_span(buf.data(), n);
                 return {};
             }
@@ -440,7 +439,7 @@ namespace scn {
             error _read_source(Context& ctx,
                                Buf& buf,
                                span<const CharT>& s,
-                               std::true_type)
+                               std::true_type) const
             {
                 if (SCN_UNLIKELY((format_options & allow_thsep) != 0)) {
                     return _read_source(ctx, buf, s, std::false_type{});
@@ -462,12 +461,14 @@ namespace scn {
                 int& b) const;
 
             template <typename CharT>
-            expected<std::ptrdiff_t> _parse_int(T& val, span<const CharT> s);
+            expected<std::ptrdiff_t> _parse_int(T& val,
+                                                span<const CharT> s) const;
 
             template <typename CharT>
             expected<typename span<const CharT>::iterator> _parse_int_impl(
                 T& val,
                 bool minus_sign,
+                int value_base,
                 span<const CharT> buf) const;
         };
 
@@ -530,7 +531,7 @@ namespace scn {
             }
 
             SCN_CLANG_PUSH_IGNORE_UNDEFINED_TEMPLATE
-            return s._parse_int_impl(val, minus_sign, buf);
+            return s._parse_int_impl(val, minus_sign, base, buf);
             SCN_CLANG_POP_IGNORE_UNDEFINED_TEMPLATE
         }
     }  // namespace detail
@@ -18,6 +18,7 @@
 #ifndef SCN_READER_STRING_H
 #define SCN_READER_STRING_H
 
+#include "../util/scratch_buffer.h"
 #include "../util/small_vector.h"
 #include "common.h"
 
@@ -293,7 +294,9 @@ namespace scn {
 
             // true = char accepted
             template <typename CharT, typename Locale>
-            bool check_character(CharT ch, bool localized, const Locale& loc)
+            bool check_character(CharT ch,
+                                 bool localized,
+                                 const Locale& loc) const
             {
                 SCN_EXPECT(get_option(flag::enabled));
 
@@ -307,55 +310,56 @@ namespace scn {
                     SCN_EXPECT(localized);  // ensured by sanitize()
                     SCN_UNUSED(localized);
                     SCN_CLANG_PUSH_IGNORE_UNDEFINED_TEMPLATE
+                    const auto classes = loc.get_localized().classify(ch);
+                    SCN_CLANG_POP_IGNORE_UNDEFINED_TEMPLATE
                     if (get_option(specifier::alnum) &&
-                        loc.get_localized().is_alnum(ch)) {
+                        (classes & ctype_class::alnum) != 0) {
                         return not_inverted;
                     }
                     if (get_option(specifier::alpha) &&
-                        loc.get_localized().is_alpha(ch)) {
+                        (classes & ctype_class::alpha) != 0) {
                         return not_inverted;
                     }
                     if (get_option(specifier::blank) &&
-                        loc.get_localized().is_blank(ch)) {
+                        (classes & ctype_class::blank) != 0) {
                         return not_inverted;
                     }
                     if (get_option(specifier::cntrl) &&
-                        loc.get_localized().is_cntrl(ch)) {
+                        (classes & ctype_class::cntrl) != 0) {
                         return not_inverted;
                     }
                     if (get_option(specifier::digit) &&
-                        loc.get_localized().is_digit(ch)) {
+                        (classes & ctype_class::digit) != 0) {
                         return not_inverted;
                     }
                     if (get_option(specifier::graph) &&
-                        loc.get_localized().is_graph(ch)) {
+                        (classes & ctype_class::graph) != 0) {
                         return not_inverted;
                     }
                     if (get_option(specifier::lower) &&
-                        loc.get_localized().is_lower(ch)) {
+                        (classes & ctype_class::lower) != 0) {
                         return not_inverted;
                     }
                     if (get_option(specifier::print) &&
-                        loc.get_localized().is_print(ch)) {
+                        (classes & ctype_class::print) != 0) {
                         return not_inverted;
                     }
                     if (get_option(specifier::punct) &&
-                        loc.get_localized().is_punct(ch)) {
+                        (classes & ctype_class::punct) != 0) {
                         return not_inverted;
                     }
                     if (get_option(specifier::space) &&
-                        loc.get_localized().is_space(ch)) {
+                        (classes & ctype_class::space) != 0) {
                         return not_inverted;
                     }
                     if (get_option(specifier::upper) &&
-                        loc.get_localized().is_upper(ch)) {
+                        (classes & ctype_class::upper) != 0) {
                         return not_inverted;
                     }
                     if (get_option(specifier::xdigit) &&
-                        loc.get_localized().is_xdigit(ch)) {
+                        (classes & ctype_class::xdigit) != 0) {
                         return not_inverted;
                     }
-                    SCN_CLANG_POP_IGNORE_UNDEFINED_TEMPLATE
                 }
 #endif
                 if (get_option(flag::use_chars) && (ch >= 0 && ch <= 0x7f)) {
@@ -615,7 +619,8 @@ namespace scn {
                         "Unexpected end of [set] in format string after ':'"};
                 }
 
-                std::basic_string<char_type> buf;
+                scratch_string<char_type> buf_storage{};
+                auto& buf = buf_storage.get();
                 while (true) {
                     if (!pctx || pctx.check_arg_end()) {
                         return {error::invalid_format_string,
@@ -1086,7 +1091,7 @@ namespace scn {
                 std::basic_string<typename Context::char_type,
                                   std::char_traits<typename Context::char_type>,
                                   Allocator>& val,
-                Context& ctx)
+                Context& ctx) const
             {
                 if (set_parser.enabled()) {
                     bool loc = (common_options & localized) != 0;
@@ -1117,7 +1122,7 @@ namespace scn {
                 std::basic_string<typename Context::char_type,
                                   std::char_traits<typename Context::char_type>,
                                   Allocator>& val,
-                Pred&& predicate)
+                Pred&& predicate) const
             {
                 using string_type = std::basic_string<
                     typename Context::char_type,
@@ -1156,7 +1161,7 @@ namespace scn {
             template <typename Context>
             struct pred {
                 Context& ctx;
-                set_parser_type& set_parser;
+                const set_parser_type& set_parser;
                 bool localized;
                 bool multibyte;
 
@@ -1192,7 +1197,8 @@ namespace scn {
 
         struct span_scanner : public string_scanner {
             template <typename Context>
-            error scan(span<typename Context::char_type>& val, Context& ctx)
+            error scan(span<typename Context::char_type>& val,
+                       Context& ctx) const
             {
                 if (val.size() == 0) {
                     return {error::invalid_scanned_value,
@@ -1225,7 +1231,7 @@ namespace scn {
             template <typename Context, typename Pred>
             error do_scan(Context& ctx,
                           span<typename Context::char_type>& val,
-                          Pred&& predicate)
+                          Pred&& predicate) const
             {
                 if (Context::range_type::is_contiguous) {
                     auto s = read_until_space_zero_copy(
@@ -1242,7 +1248,8 @@ namespace scn {
                     return {};
                 }
 
-                std::basic_string<typename Context::char_type> tmp;
+                scratch_string<typename Context::char_type> tmp_storage{};
+                auto& tmp = tmp_storage.get();
                 auto outputit = std::back_inserter(tmp);
                 auto ret = read_until_space(ctx.range(), outputit,
                                             SCN_FWD(predicate), false);
@@ -1264,7 +1271,7 @@ namespace scn {
         public:
             template <typename Context>
             error scan(basic_string_view<typename Context::char_type>& val,
-                       Context& ctx)
+                       Context& ctx) const
             {
                 if (!Context::range_type::is_contiguous) {
                     return {error::invalid_operation,
@@ -1297,7 +1304,7 @@ namespace scn {
             template <typename Context, typename Pred>
             error do_scan(Context& ctx,
                           basic_string_view<typename Context::char_type>& val,
-                          Pred&& predicate)
+                          Pred&& predicate) const
             {
                 SCN_EXPECT(Context::range_type::is_contiguous);
 
@@ -1320,7 +1327,7 @@ namespace scn {
         struct std_string_view_scanner : string_view_scanner {
             template <typename Context>
             error scan(std::basic_string_view<typename Context::char_type>& val,
-                       Context& ctx)
+                       Context& ctx) const
             {
                 using char_type = typename Context::char_type;
                 auto sv =
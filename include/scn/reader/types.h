@@ -42,7 +42,7 @@ namespace scn {
             }
 
             template <typename Context>
-            error scan(code_point& val, Context& ctx)
+            error scan(code_point& val, Context& ctx) const
             {
                 unsigned char buf[4] = {0};
                 auto cp = read_code_point(ctx.range(), make_span(buf, 4));
@@ -100,7 +100,7 @@ namespace scn {
             }
 
             template <typename Context>
-            error scan(bool& val, Context& ctx)
+            error scan(bool& val, Context& ctx) const
             {
                 using char_type = typename Context::char_type;
 
@@ -115,7 +115,8 @@ namespace scn {
 #endif
                     const auto max_len =
                         detail::max(truename.size(), falsename.size());
-                    std::basic_string<char_type> buf;
+                    scratch_string<char_type> buf_storage{};
+                    auto& buf = buf_storage.get();
                     buf.reserve(max_len);
 
                     auto tmp_it = std::back_inserter(buf);
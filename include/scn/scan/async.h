@@ -0,0 +1,337 @@
+// Copyright 2017 Elias Kosunen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// This file is a part of scnlib:
+//     https://github.com/eliaskosunen/scnlib
+
+#ifndef SCN_SCAN_ASYNC_H
+#define SCN_SCAN_ASYNC_H
+
+#include "../detail/file.h"
+#include "push.h"
+
+#if SCN_HAS_COROUTINES
+
+#include <coroutine>
+#include <exception>
+#include <vector>
+
+// gcc reports the switch it generates for coroutine suspension points
+SCN_GCC_PUSH
+SCN_GCC_IGNORE("-Wswitch-default")
+
+namespace scn {
+    SCN_BEGIN_NAMESPACE
+
+    /**
+     * A lazily started coroutine, producing a value of type `T`.
+     *
+     * Awaiting it from another coroutine starts it, and resumes the awaiting
+     * coroutine once it has finished.
+     * A top-level task (one that's not awaited) is started with `start()`,
+     * after which it runs until its first suspension point, and is then
+     * resumed by whatever it's waiting for (usually an executor).
+     */
+    template <typename T>
+    class async_task {
+    public:
+        struct promise_type;
+        using handle_type = std::coroutine_handle<promise_type>;
+
+        struct promise_type {
+            struct final_awaiter {
+                bool await_ready() const noexcept
+                {
+                    return false;
+                }
+                std::coroutine_handle<> await_suspend(
+                    handle_type h) const noexcept
+                {
+                    // If the task finished without suspending, the awaiting
+                    // coroutine is continued from `async_task::await_suspend`
+                    auto& p = h.promise();
+                    if (p.continuation && !p.starting) {
+                        return p.continuation;
+                    }
+                    return std::noop_coroutine();
+                }
+                void await_resume() const noexcept {}
+            };
+
+            async_task get_return_object() noexcept
+            {
+                return async_task{handle_type::from_promise(*this)};
+            }
+            std::suspend_always initial_suspend() const noexcept
+            {
+                return {};
+            }
+            final_awaiter final_suspend() const noexcept
+            {
+                return {};
+            }
+
+            void return_value(T v)
+            {
+                value = std::move(v);
+            }
+            void unhandled_exception() noexcept
+            {
+#if SCN_HAS_EXCEPTIONS
+                exception = std::current_exception();
+#else
+                std::terminate();
+#endif
+            }
+
+            T value{};
+            std::coroutine_handle<> continuation{};
+            bool starting{false};
+#if SCN_HAS_EXCEPTIONS
+            std::exception_ptr exception{};
+#endif
+        };
+
+        async_task() = default;
+
+        async_task(const async_task&) = delete;
+        async_task& operator=(const async_task&) = delete;
+
+        async_task(async_task&& o) noexcept
+            : m_handle(exchange(o.m_handle, nullptr))
+        {
+        }
+        async_task& operator=(async_task&& o) noexcept
+        {
+            if (m_handle) {
+                m_handle.destroy();
+            }
+            m_handle = exchange(o.m_handle, nullptr);
+            return *this;
+        }
+
+        ~async_task()
+        {
+            if (m_handle) {
+                m_handle.destroy();
+            }
+        }
+
+        /// Starts a top-level task
+        void start()
+        {
+            SCN_EXPECT(m_handle && !m_handle.done());
+            m_handle.resume();
+        }
+        /// Returns `true`, if the task has finished
+        SCN_NODISCARD bool done() const noexcept
+        {
+            return m_handle && m_handle.done();
+        }
+        /// The value produced by the task. Requires `done()`.
+        T& result()
+        {
+            SCN_EXPECT(done());
+            _rethrow();
+            return m_handle.promise().value;
+        }
+
+        bool await_ready() const noexcept
+        {
+            return done();
+        }
+        bool await_suspend(std::coroutine_handle<> awaiting) noexcept
+        {
+            // Run the task until it either finishes or suspends.
+            // If it finished, continue without suspending, so that awaiting
+            // tasks completing synchronously in a loop doesn't grow the stack.
+            auto& p = m_handle.promise();
+            p.continuation = awaiting;
+            p.starting = true;
+            m_handle.resume();
+            p.starting = false;
+            return !m_handle.done();
+        }
+        T await_resume()
+        {
+            _rethrow();
+            return std::move(m_handle.promise().value);
+        }
+
+    private:
+        explicit async_task(handle_type h) noexcept : m_handle(h) {}
+
+        void _rethrow()
+        {
+#if SCN_HAS_EXCEPTIONS
+            if (m_handle.promise().exception) {
+                std::rethrow_exception(m_handle.promise().exception);
+            }
+#endif
+        }
+
+        handle_type m_handle{nullptr};
+    };
+
+    /**
+     * A source reading from a non-blocking file descriptor (a pipe or a
+     * socket), for use with `async_scan()`.
+     *
+     * When no data is available, `refill()` suspends on
+     * `co_await executor.readable(fd)`, instead of blocking the thread.
+     * `Executor` is any type, with a member function `readable(fd)`, returning
+     * an awaitable, which is resumed once `fd` has become readable.
+     *
+     * The data read is given to a `push_scanner`, so a value split between
+     * two reads is scanned once the rest of it has arrived, without
+     * re-scanning the input before it.
+     * Two buffers of `chunk_size` bytes are used in turns, so that the
+     * previous chunk stays valid until the next one has been fed.
+     *
+     * The file descriptor is not owned, and must be in non-blocking mode.
+     */
+    template <typename Executor>
+    class async_fd_source {
+    public:
+        using handle_type = detail::native_file_handle::handle_type;
+
+        async_fd_source(Executor& ex,
+                        handle_type fd,
+                        std::size_t chunk_size = 4096)
+            : m_executor(ex),
+              m_fd{fd},
+              m_buffers{std::vector<char>(chunk_size),
+                        std::vector<char>(chunk_size)}
+        {
+            SCN_EXPECT(chunk_size > 0);
+        }
+
+        /// The scanner holding the data not yet consumed
+        push_scanner& scanner() noexcept
+        {
+            return m_scanner;
+        }
+
+        /**
+         * Reads the next chunk from the file descriptor, and feeds it to
+         * `scanner()`, waiting for the file descriptor to become readable,
+         * if necessary.
+         * On EOF, calls `scanner().finish()` instead.
+         */
+        async_task<error> refill()
+        {
+            SCN_EXPECT(!m_scanner.finished());
+            auto& buf = m_buffers[m_next];
+            while (true) {
+                auto n = detail::read_nonblocking(
+                    m_fd, {buf.data(), buf.size()});
+                if (!n) {
+                    co_return n.error();
+                }
+                if (n.value() > 0) {
+                    m_scanner.feed(
+                        {buf.data(), static_cast<size_t>(n.value())});
+                    m_next ^= 1;
+                    co_return error{};
+                }
+                if (n.value() == 0) {
+                    m_scanner.finish();
+                    co_return error{};
+                }
+                co_await m_executor.readable(m_fd.handle);
+            }
+        }
+
+    private:
+        Executor& m_executor;
+        detail::native_file_handle m_fd;
+        std::vector<char> m_buffers[2];
+        push_scanner m_scanner{};
+        unsigned m_next{0};
+    };
+
+    /**
+     * Scans from `source`, like `scn::scan()`, suspending whenever more input
+     * is needed, until `source.refill()` has provided it.
+     *
+     * `source` is any type with the member functions `scanner()`, returning
+     * a `basic_push_scanner&`, and `refill()`, returning an awaitable
+     * yielding an `error`, see `async_fd_source`.
+     *
+     * `source`, `f` and `a...` are taken by reference, and must outlive the
+     * returned task.
+     *
+     * \code{.cpp}
+     * scn::async_fd_source<my_executor> source{executor, fd};
+     * int i;
+     * auto e = co_await scn::async_scan(source, "{}", i);
+     * \endcode
+     */
+    template <typename Source, typename Format, typename... Args>
+    async_task<error> async_scan(Source& source,
+                                 const Format& f,
+                                 Args&... a)
+    {
+        while (true) {
+            auto e = source.scanner().scan(f, a...);
+            if (e.code() != error::need_more_input) {
+                co_return e;
+            }
+            auto r = co_await source.refill();
+            if (!r) {
+                co_return r;
+            }
+        }
+    }
+
+    /// Equivalent to `async_scan()`, with `scan_default()` semantics
+    template <typename Source, typename... Args>
+    async_task<error> async_scan_default(Source& source, Args&... a)
+    {
+        while (true) {
+            auto e = source.scanner().scan_default(a...);
+            if (e.code() != error::need_more_input) {
+                co_return e;
+            }
+            auto r = co_await source.refill();
+            if (!r) {
+                co_return r;
+            }
+        }
+    }
+
+    /// Equivalent to `async_scan()`, with `ignore_until()` semantics
+    template <typename Source, typename CharT>
+    async_task<error> async_ignore_until(Source& source, CharT until)
+    {
+        while (true) {
+            auto e = source.scanner().ignore_until(until);
+            if (e.code() != error::need_more_input) {
+                co_return e;
+            }
+            auto r = co_await source.refill();
+            if (!r) {
+                co_return r;
+            }
+        }
+    }
+
+    SCN_END_NAMESPACE
+}  // namespace scn
+
+SCN_GCC_POP
+
+#endif  // SCN_HAS_COROUTINES
+
+#endif  // SCN_SCAN_ASYNC_H
@@ -0,0 +1,308 @@
+// Copyright 2017 Elias Kosunen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// This file is a part of scnlib:
+//     https://github.com/eliaskosunen/scnlib
+
+#ifndef SCN_SCAN_COLUMNS_H
+#define SCN_SCAN_COLUMNS_H
+
+#include "vscan.h"
+
+namespace scn {
+    SCN_BEGIN_NAMESPACE
+
+    /**
+     * Error type of the result object returned by \ref scan_columns.
+     *
+     * In addition to the error, contains the number of rows that were
+     * successfully read and appended into the columns.
+     */
+    struct wrapped_columns_error : wrapped_error {
+        wrapped_columns_error() = default;
+        wrapped_columns_error(::scn::error e, std::size_t r)
+            : wrapped_error(e), row_count(r)
+        {
+        }
+
+        /// Number of complete rows appended into every column
+        SCN_NODISCARD std::size_t rows() const
+        {
+            return row_count;
+        }
+
+        std::size_t row_count{0};
+    };
+
+    namespace detail {
+        template <typename Context, typename ParseCtx, typename... Columns>
+        struct column_values;
+
+        template <typename Context, typename ParseCtx>
+        struct column_values<Context, ParseCtx> {
+            error scan(std::ptrdiff_t, Context&, ParseCtx&)
+            {
+                return {error::invalid_format_string,
+                        "Argument id out of range"};
+            }
+
+            SCN_NODISCARD constexpr bool all_scanned() const
+            {
+                return true;
+            }
+            SCN_NODISCARD constexpr bool any_scanned() const
+            {
+                return false;
+            }
+            SCN_NODISCARD constexpr bool full() const
+            {
+                return false;
+            }
+
+            void reserve(std::size_t) {}
+            void push_back() {}
+        };
+
+        template <typename Container>
+        auto reserve_column(Container& c, std::size_t n, priority_tag<1>)
+            -> decltype(c.reserve(n), void())
+        {
+            c.reserve(n);
+        }
+        template <typename Container>
+        void reserve_column(Container&, std::size_t, priority_tag<0>)
+        {
+        }
+
+        /**
+         * Holds the value currently being read for every column, and the
+         * containers they're appended into.
+         *
+         * Column `N` is scanned by `scan(N, ...)`, which calls the scanner
+         * for `Container::value_type` directly, without going through
+         * `basic_args`.
+         */
+        template <typename Context,
+                  typename ParseCtx,
+                  typename Container,
+                  typename... Containers>
+        struct column_values<Context, ParseCtx, Container, Containers...>
+            : column_values<Context, ParseCtx, Containers...> {
+            using base = column_values<Context, ParseCtx, Containers...>;
+            using value_type = typename Container::value_type;
+
+            column_values(Container& c, Containers&... cs)
+                : base(cs...), column(c)
+            {
+            }
+
+            error scan(std::ptrdiff_t id, Context& ctx, ParseCtx& pctx)
+            {
+                if (id != 0) {
+                    return base::scan(id - 1, ctx, pctx);
+                }
+                auto e = visitor_boilerplate<scanner<value_type>>(value, ctx,
+                                                                  pctx);
+                if (e) {
+                    scanned = true;
+                }
+                return e;
+            }
+
+            SCN_NODISCARD bool all_scanned() const
+            {
+                return scanned && base::all_scanned();
+            }
+            SCN_NODISCARD bool any_scanned() const
+            {
+                return scanned || base::any_scanned();
+            }
+            SCN_NODISCARD bool full() const
+            {
+                return column.size() == column.max_size() || base::full();
+            }
+
+            void reserve(std::size_t n)
+            {
+                reserve_column(column, column.size() + n, priority_tag<1>{});
+                base::reserve(n);
+            }
+            void push_back()
+            {
+                column.push_back(SCN_MOVE(value));
+                scanned = false;
+                base::push_back();
+            }
+
+            Container& column;
+            value_type value{};
+            bool scanned{false};
+        };
+
+        template <typename WrappedRange>
+        auto range_size_hint(const WrappedRange& r, priority_tag<1>)
+            -> decltype(r.size(), std::ptrdiff_t{})
+        {
+            return static_cast<std::ptrdiff_t>(r.size());
+        }
+        template <typename WrappedRange>
+        std::ptrdiff_t range_size_hint(const WrappedRange&, priority_tag<0>)
+        {
+            return -1;
+        }
+
+        template <typename Context, typename CharT, typename... Columns>
+        error scan_columns_impl(Context& ctx,
+                                basic_string_view<CharT> f,
+                                std::size_t& rows,
+                                Columns&... c)
+        {
+            using parse_context_type = basic_parse_context<CharT>;
+            column_values<Context, parse_context_type, Columns...> values(c...);
+
+            while (!values.full()) {
+                const auto size_before =
+                    range_size_hint(ctx.range(), priority_tag<1>{});
+
+                auto pctx = parse_context_type(f, ctx.locale());
+                auto err = visit_format(
+                    ctx, pctx,
+                    [](std::ptrdiff_t id) -> expected<std::ptrdiff_t> {
+                        if (id < 0 || static_cast<std::size_t>(id) >=
+                                          sizeof...(Columns)) {
+                            return error(error::invalid_format_string,
+                                         "Argument id out of range");
+                        }
+                        return id;
+                    },
+                    [&](std::ptrdiff_t id) -> error {
+                        return values.scan(id, ctx, pctx);
+                    });
+                if (!err) {
+                    const bool eof = ctx.range().empty();
+                    auto rb = ctx.range().reset_to_rollback_point();
+                    if (!rb) {
+                        return rb;
+                    }
+                    if (!values.any_scanned()) {
+                        if (err == error::end_of_range) {
+                            // EOF between rows
+                            return {};
+                        }
+                        return err;
+                    }
+                    if (eof) {
+                        return {error::end_of_range,
+                                "Unexpected end of range in the middle of a "
+                                "row"};
+                    }
+                    return err;
+                }
+                if (SCN_UNLIKELY(!values.all_scanned())) {
+                    return {error::invalid_format_string,
+                            "Every column needs to be read on every row"};
+                }
+
+                values.push_back();
+                ++rows;
+
+                if (rows == 1 && size_before > 0) {
+                    // Estimate the number of rows left based on the length
+                    // of the first one
+                    const auto size_after =
+                        range_size_hint(ctx.range(), priority_tag<1>{});
+                    const auto row_size = size_before - size_after;
+                    if (row_size > 0) {
+                        values.reserve(
+                            static_cast<std::size_t>(size_after / row_size) +
+                            1);
+                    }
+                }
+            }
+            return {};
+        }
+    }  // namespace detail
+
+    /**
+     * Reads rows of values from `r`, according to the format string `f`,
+     * and appends each value into its own column container.
+     *
+     * The `N`th argument of the format string is read into a value of type
+     * `Container::value_type` of the `N`th container, and written into it
+     * with `push_back`. Every column needs to be read exactly once per row.
+     * After reading the first row, the containers are `reserve`d (if they
+     * support it), based on an estimate of the number of rows left in `r`.
+     *
+     * Unlike calling \ref scan in a loop, the values aren't type-erased on
+     * every row: the scanners of the value types are called directly.
+     *
+     * The range is read until:
+     *  - `max_size()` of a container is reached, or
+     *  - range `EOF` is reached between rows
+     *
+     * In these cases, an error will not be returned.
+     *
+     * If a row fails to be read, its error is returned, and the returned range
+     * begins where that row began to be read, including the whitespace before
+     * it. Values from the incomplete row are not added, so every container
+     * will have `result.rows()` new elements.
+     *
+     * \code{.cpp}
+     * std::vector<int> ids;
+     * std::vector<double> values;
+     * auto result = scn::scan_columns("1 3.14\n2 2.5\n3 x\n4 1", "{} {}",
+     *                                 ids, values);
+     * // ids == [1, 2], values == [3.14, 2.5]
+     * // result.rows() == 2
+     * // result.error() == invalid_scanned_value
+     * // result.range_as_string() == "\n3 x\n4 1"
+     * \endcode
+     *
+     * \param r Range to read from
+     * \param f Format string for a single row
+     * \param c Containers to write values to, one per format string argument
+     */
+#if SCN_DOXYGEN
+    template <typename Range, typename Format, typename... Containers>
+    auto scan_columns(Range&& r, const Format& f, Containers&... c)
+        -> detail::generic_scan_result_for_range<wrapped_columns_error, Range>;
+#else
+    template <typename Range, typename Format, typename... Containers>
+    SCN_NODISCARD auto scan_columns(Range&& r,
+                                    const Format& f,
+                                    Containers&... c)
+        -> detail::generic_scan_result_for_range<wrapped_columns_error, Range>
+    {
+        static_assert(sizeof...(Containers) > 0,
+                      "Have to scan at least a single column");
+        static_assert(SCN_CHECK_CONCEPT(ranges::range<Range>),
+                      "Input needs to be a Range");
+
+        auto range = wrap(SCN_FWD(r));
+        auto ctx = make_context(SCN_MOVE(range));
+
+        std::size_t rows{0};
+        auto err =
+            detail::scan_columns_impl(ctx, detail::to_format(f), rows, c...);
+
+        return detail::wrap_result(wrapped_columns_error{err, rows},
+                                   detail::range_tag<Range>{},
+                                   SCN_MOVE(ctx.range()));
+    }
+#endif
+
+    SCN_END_NAMESPACE
+}  // namespace scn
+
+#endif  // SCN_SCAN_COLUMNS_H
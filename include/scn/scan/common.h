@@ -20,6 +20,8 @@
 
 #include "../detail/locale.h"
 #include "../detail/result.h"
+#include "../detail/simd.h"
+#include "../detail/validated_view.h"
 #include "../unicode/common.h"
 
 namespace scn {
@@ -80,6 +82,35 @@ namespace scn {
             {
                 return size != 1;
             }
+
+            /**
+             * Returns a pointer to the first occurrence of a single code unit
+             * `until` in `[begin, end)`, or `nullptr`, if the vectorized
+             * search in `simd.h` can't be used.
+             */
+            const CharT* find(const CharT* begin,
+                              const CharT* end,
+                              bool stop) const
+            {
+                if (!stop || size != 1) {
+                    return nullptr;
+                }
+                return find_single(begin, end, until[0]);
+            }
+
+        private:
+            static const char* find_single(const char* begin,
+                                           const char* end,
+                                           char ch)
+            {
+                return find_char(begin, end, ch);
+            }
+            static const wchar_t* find_single(const wchar_t*,
+                                              const wchar_t*,
+                                              wchar_t)
+            {
+                return nullptr;
+            }
         };
 
         template <typename Error, typename Range>
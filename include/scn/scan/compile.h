@@ -0,0 +1,581 @@
+// Copyright 2017 Elias Kosunen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// This file is a part of scnlib:
+//     https://github.com/eliaskosunen/scnlib
+
+#ifndef SCN_SCAN_COMPILE_H
+#define SCN_SCAN_COMPILE_H
+
+#include "steps.h"
+
+#include <tuple>
+#include <utility>
+
+#if SCN_HAS_RELAXED_CONSTEXPR || SCN_DOXYGEN
+
+namespace scn {
+    SCN_BEGIN_NAMESPACE
+
+    namespace detail {
+        /**
+         * Base class of the types created by `SCN_STRING`.
+         */
+        struct compiled_string {
+        };
+
+        template <typename S>
+        struct is_compiled_string : std::is_base_of<compiled_string, S> {
+        };
+
+        /// What kind of format specifiers the scanner of a type accepts
+        enum class compiled_arg_category : unsigned char {
+            custom,
+            integer,
+            floating,
+            boolean,
+            code_point,
+            string
+        };
+
+        template <typename CharT, typename T, typename = void>
+        struct compiled_arg_category_for
+            : std::integral_constant<compiled_arg_category,
+                                     compiled_arg_category::custom> {
+        };
+        template <typename CharT, typename T>
+        struct compiled_arg_category_for<
+            CharT,
+            T,
+            typename std::enable_if<std::is_integral<T>::value &&
+                                    !std::is_same<T, bool>::value>::type>
+            : std::integral_constant<compiled_arg_category,
+                                     compiled_arg_category::integer> {
+        };
+        template <typename CharT, typename T>
+        struct compiled_arg_category_for<
+            CharT,
+            T,
+            typename std::enable_if<std::is_floating_point<T>::value>::type>
+            : std::integral_constant<compiled_arg_category,
+                                     compiled_arg_category::floating> {
+        };
+        template <typename CharT>
+        struct compiled_arg_category_for<CharT, bool>
+            : std::integral_constant<compiled_arg_category,
+                                     compiled_arg_category::boolean> {
+        };
+        template <typename CharT>
+        struct compiled_arg_category_for<CharT, code_point>
+            : std::integral_constant<compiled_arg_category,
+                                     compiled_arg_category::code_point> {
+        };
+        template <typename CharT, typename Allocator>
+        struct compiled_arg_category_for<
+            CharT,
+            std::basic_string<CharT, std::char_traits<CharT>, Allocator>>
+            : std::integral_constant<compiled_arg_category,
+                                     compiled_arg_category::string> {
+        };
+        template <typename CharT>
+        struct compiled_arg_category_for<CharT, basic_string_view<CharT>>
+            : std::integral_constant<compiled_arg_category,
+                                     compiled_arg_category::string> {
+        };
+        template <typename CharT>
+        struct compiled_arg_category_for<CharT, span<CharT>>
+            : std::integral_constant<compiled_arg_category,
+                                     compiled_arg_category::string> {
+        };
+#if SCN_HAS_STRING_VIEW
+        template <typename CharT>
+        struct compiled_arg_category_for<CharT, std::basic_string_view<CharT>>
+            : std::integral_constant<compiled_arg_category,
+                                     compiled_arg_category::string> {
+        };
+#endif
+
+        /**
+         * Check the format specifier in `[begin, end)` (`end` pointing to the
+         * closing brace) for a type of `category`, following the grammar of
+         * `common_parser::parse_common` and the type flags of the scanners.
+         *
+         * Only catches the errors detectable without running the scanner's
+         * `parse()`, which is done the first time the format is used.
+         */
+        template <typename CharT>
+        SCN_CONSTEXPR14 bool check_compiled_specifier(
+            basic_string_view<CharT> f,
+            std::size_t begin,
+            std::size_t end,
+            compiled_arg_category category)
+        {
+            if (category == compiled_arg_category::custom || begin == end) {
+                return true;
+            }
+
+            auto i = begin;
+            // [[fill]align]
+            if (end - i > 1 && f[i] != static_cast<CharT>('[') &&
+                is_format_align(f[i + 1])) {
+                i += 2;
+            }
+            else if (is_format_align(f[i])) {
+                ++i;
+            }
+            // [width] or ['L']
+            if (i != end && is_format_digit(f[i])) {
+                while (i != end && is_format_digit(f[i])) {
+                    ++i;
+                }
+            }
+            else if (i != end && f[i] == static_cast<CharT>('L')) {
+                ++i;
+            }
+
+            const char* options = "";
+            // custom was handled above, the default is for -Wswitch-default
+            SCN_CLANG_PUSH
+            SCN_CLANG_IGNORE("-Wcovered-switch-default")
+            switch (category) {
+                case compiled_arg_category::integer:
+                    options = "dboxiucn'";
+                    break;
+                case compiled_arg_category::floating:
+                    options = "aAeEfFgGn'";
+                    break;
+                case compiled_arg_category::boolean:
+                    options = "sin";
+                    break;
+                case compiled_arg_category::code_point:
+                    options = "c";
+                    break;
+                case compiled_arg_category::string:
+                    options = "s";
+                    break;
+                case compiled_arg_category::custom:
+                default:
+                    break;
+            }
+            SCN_CLANG_POP
+
+            unsigned seen = 0;
+            int base_flags = 0;
+            while (i != end) {
+                const auto ch = f[i];
+
+                bool found = false;
+                for (unsigned j = 0; options[j] != '\0'; ++j) {
+                    if (ch == static_cast<CharT>(options[j])) {
+                        if ((seen & (1u << j)) != 0) {
+                            // Repeat flag
+                            return false;
+                        }
+                        seen |= 1u << j;
+                        if (category == compiled_arg_category::integer &&
+                            j < 6) {
+                            ++base_flags;
+                        }
+                        found = true;
+                        break;
+                    }
+                }
+                if (found) {
+                    ++i;
+                    continue;
+                }
+
+                if (category == compiled_arg_category::integer &&
+                    ch == static_cast<CharT>('B')) {
+                    // B__, custom base
+                    ++i;
+                    if (i == end || !is_format_digit(f[i])) {
+                        return false;
+                    }
+                    auto b = static_cast<int>(f[i] - 0x30);
+                    ++i;
+                    if (i != end && is_format_digit(f[i])) {
+                        b = b * 10 + static_cast<int>(f[i] - 0x30);
+                        ++i;
+                    }
+                    if (b < 2 || b > 36) {
+                        return false;
+                    }
+                    ++base_flags;
+                    continue;
+                }
+                if (category == compiled_arg_category::string &&
+                    ch == static_cast<CharT>('[')) {
+                    // [set], contents checked by set_parser_type
+                    ++i;
+                    if (i != end && f[i] == static_cast<CharT>('^')) {
+                        ++i;
+                    }
+                    if (i != end && f[i] == static_cast<CharT>(']')) {
+                        ++i;
+                        continue;
+                    }
+                    while (i != end && f[i] != static_cast<CharT>(']')) {
+                        i += f[i] == static_cast<CharT>('\\')
+                                 ? std::size_t{2}
+                                 : std::size_t{1};
+                        if (i > end) {
+                            return false;
+                        }
+                    }
+                    if (i == end) {
+                        return false;
+                    }
+                    ++i;
+                    continue;
+                }
+                return false;
+            }
+            return base_flags <= 1;
+        }
+
+        /**
+         * Steps of the compiled format string `S`, parsed at compile time.
+         */
+        template <typename S>
+        struct compiled_format_steps {
+            using char_type = typename S::char_type;
+
+            static SCN_CONSTEXPR14 basic_string_view<char_type> str()
+            {
+                return S{};
+            }
+
+            static constexpr format_parse_result info =
+                parse_compiled_format(str(), nullptr, 0);
+            static constexpr std::size_t max_size =
+                info.steps > 0 ? info.steps : 1;
+
+            static SCN_CONSTEXPR14 array<compiled_step, max_size> make()
+            {
+                array<compiled_step, max_size> a{};
+                parse_compiled_format(str(), a.data(), max_size);
+                return a;
+            }
+
+            static constexpr array<compiled_step, max_size> steps = make();
+
+            static constexpr std::size_t size()
+            {
+                return info.steps;
+            }
+        };
+#if SCN_STD < SCN_STD_17
+        template <typename S>
+        constexpr format_parse_result compiled_format_steps<S>::info;
+        template <typename S>
+        constexpr std::size_t compiled_format_steps<S>::max_size;
+        template <typename S>
+        constexpr array<compiled_step, compiled_format_steps<S>::max_size>
+            compiled_format_steps<S>::steps;
+#endif
+
+        /**
+         * Check the compiled format string `S` against the argument types
+         * `Args`. Returns the first error found.
+         */
+        template <typename S, typename... Args>
+        SCN_CONSTEXPR14 format_compile_error check_compiled_format()
+        {
+            using steps_type = compiled_format_steps<S>;
+            using char_type = typename S::char_type;
+
+            if (steps_type::info.error != format_compile_error::none) {
+                return steps_type::info.error;
+            }
+            if (steps_type::info.args > sizeof...(Args)) {
+                return format_compile_error::arg_id_out_of_range;
+            }
+
+            const compiled_arg_category categories[] = {
+                compiled_arg_category_for<char_type, Args>::value...,
+                compiled_arg_category::custom};
+            for (std::size_t i = 0; i < steps_type::size(); ++i) {
+                const auto step = steps_type::steps[i];
+                if (step.kind != compiled_step_kind::argument) {
+                    continue;
+                }
+                if (!check_compiled_specifier(steps_type::str(), step.begin,
+                                              step.end - 1,
+                                              categories[step.arg_id])) {
+                    return format_compile_error::invalid_specifier;
+                }
+            }
+            return format_compile_error::none;
+        }
+
+        template <typename T>
+        struct configured_scanner {
+            scanner<T> value{};
+            error err{};
+        };
+
+        /**
+         * Parse the format specifier of step `I` of `S` for `T`.
+         *
+         * `scanner::parse()` isn't `constexpr`, so this is done lazily, once,
+         * the first time the step is used, and the result is kept in a
+         * function-local static: later calls only check its guard.
+         */
+        template <typename S, std::size_t I, typename T>
+        const configured_scanner<T>& get_configured_scanner()
+        {
+            using char_type = typename S::char_type;
+            using steps_type = compiled_format_steps<S>;
+
+            static const configured_scanner<T> s = [] {
+                configured_scanner<T> ret{};
+                constexpr auto step = steps_type::steps[I];
+                const auto str = steps_type::str();
+
+                auto locale = basic_locale_ref<char_type>{};
+                auto pctx = basic_parse_context<char_type>(
+                    basic_string_view<char_type>(str.data() + step.begin,
+                                                 step.end - step.begin),
+                    locale);
+                ret.err = pctx.parse(ret.value);
+                return ret;
+            }();
+            return s;
+        }
+
+        template <compiled_step_kind Kind>
+        using compiled_step_tag =
+            std::integral_constant<compiled_step_kind, Kind>;
+
+        template <typename S, std::size_t I>
+        struct compiled_step_runner;
+
+        template <typename S>
+        struct compiled_step_runner_end {
+            template <typename Context, typename Args>
+            static error run(Context& ctx, Args&)
+            {
+                ctx.range().set_rollback_point();
+                return {};
+            }
+        };
+
+        template <typename S, std::size_t I>
+        using compiled_step_runner_for = typename std::conditional<
+            I == compiled_format_steps<S>::size(),
+            compiled_step_runner_end<S>,
+            compiled_step_runner<S, I>>::type;
+
+        /**
+         * Runs step `I` of `S`, and then the steps after it.
+         */
+        template <typename S, std::size_t I>
+        struct compiled_step_runner {
+            using steps_type = compiled_format_steps<S>;
+            static constexpr compiled_step step = steps_type::steps[I];
+
+            template <typename Context, typename Args>
+            static error run(Context& ctx,
+                             Args& args,
+                             compiled_step_tag<compiled_step_kind::whitespace>)
+            {
+                auto err =
+                    run_whitespace_step(ctx, I + 1 == steps_type::size());
+                if (!err) {
+                    return err;
+                }
+                return compiled_step_runner_for<S, I + 1>::run(ctx, args);
+            }
+
+            template <typename Context, typename Args>
+            static error run(Context& ctx,
+                             Args& args,
+                             compiled_step_tag<compiled_step_kind::literal>)
+            {
+                const auto str = steps_type::str();
+                auto err = run_literal_step(
+                    ctx, basic_string_view<typename Context::char_type>(
+                             str.data() + step.begin, step.end - step.begin));
+                if (!err) {
+                    return err;
+                }
+                return compiled_step_runner_for<S, I + 1>::run(ctx, args);
+            }
+
+            template <typename Context, typename Args>
+            static error run(Context& ctx,
+                             Args& args,
+                             compiled_step_tag<compiled_step_kind::argument>)
+            {
+                using value_type = typename std::remove_reference<
+                    typename std::tuple_element<step.arg_id, Args>::type>::type;
+
+                const auto& configured =
+                    get_configured_scanner<S, I, value_type>();
+                auto err = configured.err;
+                if (err) {
+                    err = scan_with_configured_scanner(
+                        configured.value, std::get<step.arg_id>(args), ctx);
+                }
+                if (!err) {
+                    auto rb = ctx.range().reset_to_rollback_point();
+                    if (!rb) {
+                        return rb;
+                    }
+                    return err;
+                }
+                return compiled_step_runner_for<S, I + 1>::run(ctx, args);
+            }
+
+            template <typename Context, typename Args>
+            static error run(Context& ctx, Args& args)
+            {
+                return run(ctx, args, compiled_step_tag<step.kind>{});
+            }
+        };
+#if SCN_STD < SCN_STD_17
+        template <typename S, std::size_t I>
+        constexpr compiled_step compiled_step_runner<S, I>::step;
+#endif
+
+    }  // namespace detail
+
+    /**
+     * A format string parsed at compile time, created with \ref compile.
+     *
+     * When scanning with a compiled format string, the format string isn't
+     * interpreted at runtime. The format specifiers of the arguments are
+     * checked at compile time, but the scanners are configured lazily: once
+     * per program, the first time each argument is scanned, after which the
+     * configured scanners are reused without copying them.
+     *
+     * \tparam S Type created with `SCN_STRING`
+     */
+    template <typename S>
+    struct compiled_format {
+        static_assert(detail::is_compiled_string<S>::value,
+                      "compiled_format needs to be created with SCN_STRING");
+
+        using char_type = typename S::char_type;
+        using steps_type = detail::compiled_format_steps<S>;
+
+        static_assert(steps_type::info.error !=
+                          detail::format_compile_error::unexpected_end,
+                      "Unexpected end of format string");
+        static_assert(steps_type::info.error !=
+                          detail::format_compile_error::invalid_arg_id,
+                      "Failed to parse argument id from format string");
+        static_assert(steps_type::info.error !=
+                          detail::format_compile_error::mixed_arg_id,
+                      "Cannot mix automatic and manual argument ids in "
+                      "format string");
+
+        /// Get the original format string
+        SCN_NODISCARD constexpr basic_string_view<char_type> get() const
+        {
+            return S{};
+        }
+    };
+
+    /**
+     * Compile the format string `s` at compile time.
+     * Use `SCN_STRING` to create `s`, or use `SCN_COMPILE`.
+     *
+     * \code{.cpp}
+     * int a, b;
+     * auto f = scn::compile(SCN_STRING("{} {:x}"));
+     * auto ret = scn::scan("123 ff", f, a, b);
+     * // a == 123, b == 0xff
+     * \endcode
+     */
+    template <typename S>
+    constexpr compiled_format<S> compile(S)
+    {
+        return {};
+    }
+
+    /**
+     * Equivalent to \ref scan, but with a format string compiled with \ref
+     * compile. Errors in the format string, including format specifiers
+     * that are invalid for the types of `a`, are compile-time errors.
+     */
+#if SCN_DOXYGEN
+    template <typename Range, typename S, typename... Args>
+    auto scan(Range&& r, const compiled_format<S>& f, Args&... a)
+        -> detail::scan_result_for_range<Range>;
+#else
+    template <typename Range, typename S, typename... Args>
+    SCN_NODISCARD auto scan(Range&& r, const compiled_format<S>&, Args&... a)
+        -> detail::scan_result_for_range<Range>
+    {
+        static_assert(sizeof...(Args) > 0,
+                      "Have to scan at least a single argument");
+        static_assert(SCN_CHECK_CONCEPT(ranges::range<Range>),
+                      "Input needs to be a Range");
+
+        constexpr auto check = detail::check_compiled_format<S, Args...>();
+        static_assert(
+            check != detail::format_compile_error::arg_id_out_of_range,
+            "Argument id out of range");
+        static_assert(check != detail::format_compile_error::invalid_specifier,
+                      "Invalid format specifier for argument type");
+
+        auto range = wrap(SCN_FWD(r));
+        static_assert(std::is_same<typename decltype(range)::char_type,
+                                   typename S::char_type>::value,
+                      "Format string and range character types differ");
+        auto ctx = make_context(SCN_MOVE(range));
+
+        auto args = std::tuple<Args&...>(a...);
+        auto err = detail::compiled_step_runner_for<S, 0>::run(ctx, args);
+
+        return detail::wrap_result(wrapped_error{err},
+                                   detail::range_tag<Range>{},
+                                   SCN_MOVE(ctx.range()));
+    }
+#endif
+
+    SCN_END_NAMESPACE
+}  // namespace scn
+
+/**
+ * Create a format string, that can be parsed at compile time with
+ * `scn::compile`.
+ *
+ * \code{.cpp}
+ * auto f = scn::compile(SCN_STRING("{} {}"));
+ * \endcode
+ */
+#define SCN_STRING(s)                                                     \
+    [] {                                                                  \
+        struct scn_compiled_string : ::scn::detail::compiled_string {     \
+            using char_type = typename ::scn::detail::remove_cvref<       \
+                decltype(s[0])>::type;                                    \
+            constexpr operator ::scn::basic_string_view<char_type>() const \
+            {                                                             \
+                return {s, sizeof(s) / sizeof(char_type) - 1};            \
+            }                                                             \
+        };                                                                \
+        return scn_compiled_string{};                                     \
+    }()
+
+/**
+ * Equivalent to `scn::compile(SCN_STRING(s))`
+ */
+#define SCN_COMPILE(s) ::scn::compile(SCN_STRING(s))
+
+#endif  // SCN_HAS_RELAXED_CONSTEXPR
+
+#endif  // SCN_SCAN_COMPILE_H
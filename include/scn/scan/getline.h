@@ -47,7 +47,7 @@ namespace scn {
                 return {};
             }
 
-            String tmp;
+            auto tmp = construct_with_allocator_of<String>(str);
             auto out = std::back_inserter(tmp);
             auto e = read_until_space(r, out, pred, true);
             if (!e) {
@@ -111,6 +111,8 @@ namespace scn {
      * Otherwise, clears `str` by calling `str.clear()`, and then reads the
      * range into `str` as if by repeatedly calling \c str.push_back.
      * `str.reserve()` is also required to be present.
+     * If `str` has an allocator (`str.get_allocator()`), it's used for any
+     * temporary storage, too.
      *
      * `Until` can either be the same as `r` character type (`char` or
      * `wchar_t`), or `code_point`.
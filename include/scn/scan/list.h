@@ -183,6 +183,136 @@ namespace scn {
             return ret.value().cp;
         }
 
+        template <typename CharT>
+        bool list_code_unit(optional<CharT> in, optional<CharT>& out)
+        {
+            out = in;
+            return true;
+        }
+        /// Converts an ASCII `code_point` into a code unit, returns `false`
+        /// if `in` isn't ASCII
+        template <typename CharT>
+        bool list_code_unit(optional<code_point> in, optional<CharT>& out)
+        {
+            if (!in) {
+                return true;
+            }
+            if (static_cast<uint32_t>(in.get()) >= 0x80) {
+                return false;
+            }
+            out = optional<CharT>{static_cast<CharT>(in.get())};
+            return true;
+        }
+
+        inline const char* skip_classic_space(const char* begin,
+                                              const char* end) noexcept
+        {
+            return find_classic_nonspace(begin, end);
+        }
+        inline const wchar_t* skip_classic_space(const wchar_t* begin,
+                                                 const wchar_t* end) noexcept
+        {
+            for (; begin != end && is_space(*begin); ++begin) {
+            }
+            return begin;
+        }
+
+        /**
+         * Skips over the separators and whitespace following a value in a
+         * list.
+         * `scanning` is set to `false`, if the end of the range, or
+         * `options.until` (which isn't skipped over) was reached.
+         *
+         * Every character is read, and classified, once: only the one that
+         * stops skipping is put back.
+         */
+        template <typename Context, typename Separator>
+        error skip_list_separators(Context& ctx,
+                                   const scan_list_options<Separator>& options,
+                                   bool& scanning,
+                                   std::false_type)
+        {
+            while (true) {
+                size_t n{0};
+                auto ret = check_separator(ctx.range(), n,
+                                           static_cast<Separator>(0));
+                if (!ret) {
+                    if (ret.error() == error::end_of_range) {
+                        scanning = false;
+                        return {};
+                    }
+                    return ret.error();
+                }
+
+                const auto next = ret.value();
+                if (options.until && next == options.until.get()) {
+                    scanning = false;
+                }
+                else if ((options.separator &&
+                          next == options.separator.get()) ||
+                         is_space(next)) {
+                    continue;
+                }
+                return putback_n(ctx.range(), static_cast<std::ptrdiff_t>(n));
+            }
+        }
+
+        // Contiguous ranges: look at the code units in place, nothing is
+        // read and then put back
+        template <typename Context, typename Separator>
+        error skip_list_separators(Context& ctx,
+                                   const scan_list_options<Separator>& options,
+                                   bool& scanning,
+                                   std::true_type)
+        {
+            using char_type = typename Context::char_type;
+
+            // A separator or until-character not representable as a single
+            // code unit needs decoding
+            optional<char_type> sep{}, until{};
+            if (!list_code_unit(options.separator, sep) ||
+                !list_code_unit(options.until, until)) {
+                return skip_list_separators(ctx, options, scanning,
+                                            std::false_type{});
+            }
+
+            if (ctx.range().empty()) {
+                scanning = false;
+                return {};
+            }
+            const auto begin = ctx.range().data();
+            const auto end = begin + ctx.range().size();
+            // A run of whitespace can't be skipped in one go, if it may
+            // contain the until-character
+            const bool skip_runs = !until || !is_space(until.get());
+            auto it = begin;
+            while (it != end) {
+                const auto ch = *it;
+                if (until && ch == until.get()) {
+                    scanning = false;
+                    break;
+                }
+                if (sep && ch == sep.get()) {
+                    ++it;
+                    continue;
+                }
+                if (!is_space(ch)) {
+                    break;
+                }
+                // Usually, only one space follows a value:
+                // don't call into the vectorized kernel for that
+                ++it;
+                if (skip_runs && it != end && is_space(*it)) {
+                    it = skip_classic_space(it, end);
+                }
+            }
+            if (it == end) {
+                scanning = false;
+            }
+            ctx.range().advance(it - begin);
+            return {};
+        }
+
         template <typename Context, typename Container, typename Separator>
         auto scan_list_impl(Context& ctx,
                             bool localized,
@@ -191,7 +321,7 @@ namespace scn {
         {
             using char_type = typename Context::char_type;
             using value_type = typename Container::value_type;
-            value_type value;
+            auto value = construct_with_allocator_of<value_type>(c);
 
             auto args = make_args_for(ctx.range(), 1, value);
 
@@ -212,80 +342,12 @@ namespace scn {
                 }
                 c.push_back(SCN_MOVE(value));
 
-                auto next = static_cast<Separator>(0);
-                size_t n{0};
-
-                auto read_next = [&]() -> error {
-                    auto ret = check_separator(ctx.range(), n,
-                                               static_cast<Separator>(0));
-                    if (!ret) {
-                        if (ret.error() == error::end_of_range) {
-                            scanning = false;
-                            return {};
-                        }
-                        return ret.error();
-                    }
-                    next = ret.value();
-
-                    err =
-                        putback_n(ctx.range(), static_cast<std::ptrdiff_t>(n));
-                    if (!err) {
-                        return err;
-                    }
-
-                    return {};
-                };
-
-                bool sep_found = false;
-                while (true) {
-                    // read until
-                    if (options.until) {
-                        err = read_next();
-                        if (!err) {
-                            return err;
-                        }
-                        if (!scanning) {
-                            break;
-                        }
-
-                        if (next == options.until.get()) {
-                            scanning = false;
-                            break;
-                        }
-                    }
-
-                    // read sep
-                    if (options.separator && !sep_found) {
-                        err = read_next();
-                        if (!err) {
-                            return err;
-                        }
-                        if (!scanning) {
-                            break;
-                        }
-
-                        if (next == options.separator.get()) {
-                            // skip to next char
-                            ctx.range().advance(static_cast<std::ptrdiff_t>(n));
-                            continue;
-                        }
-                    }
-
-                    err = read_next();
-                    if (!err) {
-                        return err;
-                    }
-                    if (!scanning) {
-                        break;
-                    }
-
-                    if (ctx.locale().get_static().is_space(next)) {
-                        // skip ws
-                        ctx.range().advance(static_cast<std::ptrdiff_t>(n));
-                    }
-                    else {
-                        break;
-                    }
+                err = skip_list_separators(
+                    ctx, options, scanning,
+                    std::integral_constant<
+                        bool, Context::range_type::is_contiguous>{});
+                if (!err) {
+                    return err;
                 }
             }
 
@@ -298,6 +360,8 @@ namespace scn {
      *
      * The values read are of type `Container::value_type`, and they are
      * written into `c` using `c.push_back`.
+     * If `c` has an allocator (`c.get_allocator()`), and the values can be
+     * constructed from it, it's used to construct them.
      * The values are separated by whitespace.
      *
      * The range is read, until:
@@ -0,0 +1,272 @@
+// Copyright 2017 Elias Kosunen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// This file is a part of scnlib:
+//     https://github.com/eliaskosunen/scnlib
+
+#ifndef SCN_SCAN_PARALLEL_H
+#define SCN_SCAN_PARALLEL_H
+
+#include "list.h"
+
+#include <future>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace scn {
+    SCN_BEGIN_NAMESPACE
+
+    namespace detail {
+        /// Chunks smaller than this (in code units) aren't worth a thread
+        static constexpr std::size_t parallel_list_min_chunk_size = 32768;
+
+        // Can a value of type T never contain the separator `sep`?
+        // True for numbers, with a separator that isn't a part of any number
+        // syntax: then, the input can be split right after a separator.
+        template <typename T, typename CharT>
+        bool list_value_excludes(CharT sep)
+        {
+            if (!std::is_arithmetic<T>::value || std::is_same<T, char>::value ||
+                std::is_same<T, wchar_t>::value) {
+                return false;
+            }
+            const auto lower = static_cast<CharT>(sep | 0x20);
+            return !((sep >= '0' && sep <= '9') ||
+                     (lower >= 'a' && lower <= 'z') || sep == '.' ||
+                     sep == '+' || sep == '-' || sep == '_');
+        }
+
+        /**
+         * Find the first index `i >= from` in `s`, where a new list value
+         * starts after a run of whitespace (or separators, if `split_sep`):
+         * there, the serial `scan_list_impl` would begin to scan a value.
+         * Returns `s.size()`, if there's none.
+         */
+        template <typename CharT>
+        std::size_t find_list_split(basic_string_view<CharT> s,
+                                    std::size_t from,
+                                    optional<CharT> sep,
+                                    optional<CharT> until,
+                                    bool split_sep)
+        {
+            auto is_sep = [&](CharT ch) { return sep && ch == sep.get(); };
+            for (auto i = from == 0 ? 1 : from; i < s.size(); ++i) {
+                const auto prev = s[i - 1], ch = s[i];
+                if (!(is_space(prev) || (split_sep && is_sep(prev)))) {
+                    continue;
+                }
+                if (is_space(ch) || is_sep(ch) ||
+                    (until && ch == until.get())) {
+                    continue;
+                }
+                return i;
+            }
+            return s.size();
+        }
+
+        template <typename T>
+        struct parallel_list_chunk {
+            std::vector<T> values{};
+            error err{};
+            std::size_t consumed{0};
+        };
+
+        template <typename T, typename CharT, typename Separator>
+        parallel_list_chunk<T> scan_list_chunk(
+            basic_string_view<CharT> chunk,
+            scan_list_options<Separator> options)
+        {
+            parallel_list_chunk<T> ret{};
+            auto ctx = make_context(wrap(chunk));
+            ret.err = scan_list_impl(ctx, false, ret.values, options);
+            ret.consumed =
+                chunk.size() - static_cast<std::size_t>(ctx.range().size());
+            return ret;
+        }
+    }  // namespace detail
+
+    /**
+     * Otherwise equivalent to `scan_list_ex()`, except the input is split
+     * into up to `n_threads` pieces, which are scanned concurrently.
+     *
+     * `r` must be contiguous (e.g. a `string_view` or a `std::string`).
+     * The input is split at whitespace between values, or, when scanning
+     * numbers, right after a separator: there, the values are scanned
+     * exactly like `scan_list_ex()` would have.
+     * Thus, the values must not contain whitespace, which is true for every
+     * built-in type.
+     * Each piece is scanned into a buffer of its own, which are then appended
+     * to `c` in order.
+     *
+     * The result, and the values in `c`, are the same as with
+     * `scan_list_ex()`: on an invalid value, the values before it are in
+     * `c`, and the returned range begins at the invalid value.
+     * `c.max_size()` and `options.until` are respected, although the pieces
+     * after them have still been scanned.
+     *
+     * If `n_threads == 0`, `std::thread::hardware_concurrency()` is used.
+     * Pieces are at least 32768 code units long, so that small inputs are
+     * scanned on the calling thread only, which also scans the first piece.
+     * If a thread can't be started, its piece is scanned on the calling
+     * thread, too.
+     *
+     * This function is declared in `<scn/scan/parallel.h>`, which isn't
+     * included by `<scn/scn.h>`, and requires linking with the platform
+     * thread library.
+     *
+     * \code{.cpp}
+     * std::vector<double> vec{};
+     * auto result = scn::scan_list_parallel(big_string, vec,
+     *                                       scn::list_separator(','), 4);
+     * \endcode
+     *
+     * \see scan_list_ex
+     */
+#if SCN_DOXYGEN
+    template <typename Range, typename Container, typename CharT>
+    auto scan_list_parallel(Range&& r,
+                            Container& c,
+                            scan_list_options<CharT> options,
+                            std::size_t n_threads = 0)
+        -> detail::scan_result_for_range<Range>;
+#else
+    template <typename Range, typename Container, typename CharT>
+    SCN_NODISCARD auto scan_list_parallel(Range&& r,
+                                          Container& c,
+                                          scan_list_options<CharT> options,
+                                          std::size_t n_threads = 0)
+        -> detail::scan_result_for_range<Range>
+    {
+        using value_type = typename Container::value_type;
+
+        auto range = wrap(SCN_FWD(r));
+        using char_type = typename decltype(range)::char_type;
+        static_assert(decltype(range)::is_contiguous,
+                      "scan_list_parallel requires a contiguous range");
+
+        const auto input = basic_string_view<char_type>{
+            range.data(), static_cast<std::size_t>(range.size())};
+
+        if (n_threads == 0) {
+            n_threads = std::thread::hardware_concurrency();
+        }
+        n_threads = (std::min)(
+            n_threads, input.size() / detail::parallel_list_min_chunk_size);
+
+        optional<char_type> sep{}, until{};
+        const bool splittable =
+            detail::list_code_unit(options.separator, sep) &&
+            detail::list_code_unit(options.until, until);
+        if (n_threads <= 1 || !splittable) {
+            auto ctx = make_context(SCN_MOVE(range));
+            auto err = detail::scan_list_impl(ctx, false, c, options);
+            return detail::wrap_result(wrapped_error{err},
+                                       detail::range_tag<Range>{},
+                                       SCN_MOVE(ctx.range()));
+        }
+
+        const bool split_sep =
+            sep && detail::list_value_excludes<value_type>(sep.get());
+        std::vector<std::size_t> bounds{0};
+        for (std::size_t i = 1; i < n_threads; ++i) {
+            const auto target = (std::max)(bounds.back() + 1,
+                                           input.size() * i / n_threads);
+            auto b = detail::find_list_split(input, target, sep, until,
+                                             split_sep);
+            if (b == input.size()) {
+                break;
+            }
+            bounds.push_back(b);
+        }
+        bounds.push_back(input.size());
+
+        auto piece = [&](std::size_t i) {
+            return basic_string_view<char_type>{input.data() + bounds[i],
+                                                bounds[i + 1] - bounds[i]};
+        };
+
+        using chunk_type = detail::parallel_list_chunk<value_type>;
+        std::vector<std::future<chunk_type>> futures;
+        for (std::size_t i = 1; i + 1 < bounds.size(); ++i) {
+            auto scan_piece = [&piece, options, i]() {
+                return detail::scan_list_chunk<value_type>(piece(i), options);
+            };
+#if SCN_HAS_EXCEPTIONS
+            try {
+                futures.push_back(
+                    std::async(std::launch::async, scan_piece));
+            }
+            catch (const std::system_error&) {
+                // No thread could be started:
+                // scan this piece on the calling thread, when it's needed
+                futures.push_back(
+                    std::async(std::launch::deferred, scan_piece));
+            }
+#else
+            futures.push_back(std::async(std::launch::async, scan_piece));
+#endif
+        }
+        auto chunk = detail::scan_list_chunk<value_type>(piece(0), options);
+
+        error err{};
+        std::size_t consumed = 0;
+        for (std::size_t i = 0; i + 1 < bounds.size(); ++i) {
+            if (i != 0) {
+                chunk = futures[i - 1].get();
+            }
+            if (c.size() == c.max_size()) {
+                break;
+            }
+            if (chunk.values.size() >= c.max_size() - c.size()) {
+                // c fills up in this piece: rescan it, to stop where
+                // scan_list_ex() would
+                auto ctx = make_context(wrap(piece(i)));
+                err = detail::scan_list_impl(ctx, false, c, options);
+                consumed = bounds[i] + piece(i).size() -
+                           static_cast<std::size_t>(ctx.range().size());
+                break;
+            }
+
+            for (auto& v : chunk.values) {
+                c.push_back(SCN_MOVE(v));
+            }
+            consumed = bounds[i] + chunk.consumed;
+            if (!chunk.err) {
+                err = chunk.err;
+                break;
+            }
+            if (chunk.consumed != piece(i).size()) {
+                // stopped at options.until
+                break;
+            }
+        }
+        // Wait for the pieces that weren't needed
+        for (auto& f : futures) {
+            if (f.valid()) {
+                f.wait();
+            }
+        }
+
+        range.advance(static_cast<std::ptrdiff_t>(consumed));
+        return detail::wrap_result(wrapped_error{err},
+                                   detail::range_tag<Range>{},
+                                   SCN_MOVE(range));
+    }
+#endif
+
+    SCN_END_NAMESPACE
+}  // namespace scn
+
+#endif  // SCN_SCAN_PARALLEL_H
@@ -0,0 +1,296 @@
+// Copyright 2017 Elias Kosunen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// This file is a part of scnlib:
+//     https://github.com/eliaskosunen/scnlib
+
+#ifndef SCN_SCAN_PREPARE_H
+#define SCN_SCAN_PREPARE_H
+
+#include "steps.h"
+
+#include <string>
+#include <vector>
+
+namespace scn {
+    SCN_BEGIN_NAMESPACE
+
+    namespace detail {
+        template <typename CharT, typename... Args>
+        struct prepared_scanners;
+
+        template <typename CharT>
+        struct prepared_scanners<CharT> {
+            error configure(std::size_t,
+                            basic_string_view<CharT>,
+                            basic_locale_ref<CharT>&,
+                            std::size_t&)
+            {
+                return {error::invalid_format_string,
+                        "Argument id out of range"};
+            }
+
+            template <typename Context>
+            error scan(std::size_t, std::size_t, Context&) const
+            {
+                return {error::invalid_format_string,
+                        "Argument id out of range"};
+            }
+        };
+
+        /**
+         * Holds the configured scanners for every argument step of a
+         * prepared format. The scanners for argument `N` are stored in
+         * `scanners` of the `N`th base, and a step refers to them with
+         * `(arg_id, index)`.
+         */
+        template <typename CharT, typename T, typename... Args>
+        struct prepared_scanners<CharT, T, Args...>
+            : prepared_scanners<CharT, Args...> {
+            using base = prepared_scanners<CharT, Args...>;
+
+            error configure(std::size_t id,
+                            basic_string_view<CharT> spec,
+                            basic_locale_ref<CharT>& locale,
+                            std::size_t& index)
+            {
+                if (id != 0) {
+                    return base::configure(id - 1, spec, locale, index);
+                }
+                scanner<T> s{};
+                auto pctx = basic_parse_context<CharT>(spec, locale);
+                auto err = pctx.parse(s);
+                if (!err) {
+                    return err;
+                }
+                index = scanners.size();
+                scanners.push_back(SCN_MOVE(s));
+                return {};
+            }
+
+            template <typename Context, typename... Rest>
+            error scan(std::size_t id,
+                       std::size_t index,
+                       Context& ctx,
+                       T& val,
+                       Rest&... rest) const
+            {
+                if (id != 0) {
+                    return base::scan(id - 1, index, ctx, rest...);
+                }
+                return scan_with_configured_scanner(scanners[index], val, ctx);
+            }
+
+            std::vector<scanner<T>> scanners;
+        };
+    }  // namespace detail
+
+    /**
+     * A format string, parsed and validated at runtime for the argument
+     * types `Args`. Created with \ref prepare.
+     *
+     * Every argument's format specifier is parsed once, when the object is
+     * created, and the configured scanner is stored. Scanning with
+     * `scan()` then only runs the stored steps, without parsing the format
+     * string again, and uses the stored scanners without copying them
+     * (except for user-defined scanners with a non-`const` `scan()`).
+     *
+     * Useful when the format string isn't known at compile time, but is
+     * used many times, for example when it comes from a configuration file.
+     * For format strings known at compile time, see \ref compile.
+     */
+    template <typename CharT, typename... Args>
+    class basic_prepared_format {
+    public:
+        using char_type = CharT;
+        using string_view_type = basic_string_view<CharT>;
+
+        explicit basic_prepared_format(string_view_type f)
+            : m_str(f.data(), f.size())
+        {
+            m_error = prepare();
+        }
+
+        /// Error encountered while preparing the format string
+        SCN_NODISCARD ::scn::error error() const
+        {
+            return m_error;
+        }
+        /// Was the format string valid
+        explicit operator bool() const
+        {
+            return m_error.operator bool();
+        }
+
+        /// Get the original format string
+        SCN_NODISCARD string_view_type get() const
+        {
+            return {m_str.data(), m_str.size()};
+        }
+
+        /**
+         * Reads from `r`, according to the prepared format string.
+         * If the format string was invalid, returns the error from `error()`
+         * without reading anything.
+         */
+#if SCN_DOXYGEN
+        template <typename Range>
+        auto scan(Range&& r, Args&... a) const
+            -> detail::scan_result_for_range<Range>;
+#else
+        template <typename Range>
+        SCN_NODISCARD auto scan(Range&& r, Args&... a) const
+            -> detail::scan_result_for_range<Range>
+        {
+            static_assert(SCN_CHECK_CONCEPT(ranges::range<Range>),
+                          "Input needs to be a Range");
+
+            auto range = wrap(SCN_FWD(r));
+            static_assert(
+                std::is_same<typename decltype(range)::char_type,
+                             char_type>::value,
+                "Format string and range character types differ");
+            auto ctx = make_context(SCN_MOVE(range));
+
+            auto err = m_error;
+            if (err) {
+                err = run(ctx, a...);
+            }
+            return detail::wrap_result(wrapped_error{err},
+                                       detail::range_tag<Range>{},
+                                       SCN_MOVE(ctx.range()));
+        }
+#endif
+
+    private:
+        struct step_type {
+            detail::compiled_step step;
+            // Index into prepared_scanners::scanners, for arguments
+            std::size_t scanner_index;
+        };
+
+        ::scn::error prepare()
+        {
+            const auto f = get();
+            auto info = detail::parse_compiled_format(f, nullptr, 0);
+            if (info.error != detail::format_compile_error::none) {
+                return detail::make_format_compile_error(info.error);
+            }
+            if (info.args > sizeof...(Args)) {
+                return {::scn::error::invalid_format_string,
+                        "Argument id out of range"};
+            }
+
+            std::vector<detail::compiled_step> steps(info.steps);
+            detail::parse_compiled_format(f, steps.data(), steps.size());
+
+            auto locale = basic_locale_ref<char_type>{};
+            m_steps.reserve(steps.size());
+            for (const auto& s : steps) {
+                std::size_t index{0};
+                if (s.kind == detail::compiled_step_kind::argument) {
+                    auto e = m_scanners.configure(
+                        s.arg_id,
+                        string_view_type(f.data() + s.begin, s.end - s.begin),
+                        locale, index);
+                    if (!e) {
+                        m_steps.clear();
+                        return e;
+                    }
+                }
+                m_steps.push_back({s, index});
+            }
+            return {};
+        }
+
+        template <typename Context>
+        ::scn::error run(Context& ctx, Args&... a) const
+        {
+            for (std::size_t i = 0; i < m_steps.size(); ++i) {
+                const auto& s = m_steps[i];
+                ::scn::error err{};
+                // Every kind is handled, the default is for -Wswitch-default
+                SCN_CLANG_PUSH
+                SCN_CLANG_IGNORE("-Wcovered-switch-default")
+                switch (s.step.kind) {
+                    case detail::compiled_step_kind::whitespace:
+                        err = detail::run_whitespace_step(
+                            ctx, i + 1 == m_steps.size());
+                        break;
+                    case detail::compiled_step_kind::literal:
+                        err = detail::run_literal_step(
+                            ctx, string_view_type(m_str.data() + s.step.begin,
+                                                  s.step.end - s.step.begin));
+                        break;
+                    case detail::compiled_step_kind::argument:
+                    default:
+                        err = m_scanners.scan(s.step.arg_id,
+                                              s.scanner_index, ctx, a...);
+                        if (!err) {
+                            auto rb = ctx.range().reset_to_rollback_point();
+                            if (!rb) {
+                                return rb;
+                            }
+                        }
+                        break;
+                }
+                SCN_CLANG_POP
+                if (!err) {
+                    return err;
+                }
+            }
+            ctx.range().set_rollback_point();
+            return {};
+        }
+
+        std::basic_string<char_type> m_str;
+        std::vector<step_type> m_steps{};
+        detail::prepared_scanners<char_type, Args...> m_scanners{};
+        ::scn::error m_error{};
+    };
+
+    template <typename... Args>
+    using prepared_format = basic_prepared_format<char, Args...>;
+    template <typename... Args>
+    using wprepared_format = basic_prepared_format<wchar_t, Args...>;
+
+    /**
+     * Parse and validate the format string `f` for the argument types
+     * `Args` at runtime.
+     *
+     * \code{.cpp}
+     * auto pf = scn::prepare<int, double>("{} {}");
+     * // pf.error() is good, if the format string is valid
+     *
+     * int i;
+     * double d;
+     * auto ret = pf.scan("123 3.14", i, d);
+     * // i == 123, d == 3.14
+     * \endcode
+     */
+    template <typename... Args, typename Format>
+    auto prepare(const Format& f) -> basic_prepared_format<
+        typename decltype(detail::to_format(f))::value_type,
+        Args...>
+    {
+        static_assert(sizeof...(Args) > 0,
+                      "Have to scan at least a single argument");
+        using char_type = typename decltype(detail::to_format(f))::value_type;
+        return basic_prepared_format<char_type, Args...>{detail::to_format(f)};
+    }
+
+    SCN_END_NAMESPACE
+}  // namespace scn
+
+#endif  // SCN_SCAN_PREPARE_H
@@ -0,0 +1,247 @@
+// Copyright 2017 Elias Kosunen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// This file is a part of scnlib:
+//     https://github.com/eliaskosunen/scnlib
+
+#ifndef SCN_SCAN_PUSH_H
+#define SCN_SCAN_PUSH_H
+
+#include "ignore.h"
+#include "scan.h"
+
+#include <string>
+
+namespace scn {
+    SCN_BEGIN_NAMESPACE
+
+    /**
+     * Scans input that arrives in chunks (network frames, decompression
+     * output), where a value can be split across two chunks.
+     *
+     * Input is given with `feed()`, and values are scanned with `scan()`,
+     * `scan_default()` and `ignore_until()`, which work like their free
+     * function counterparts, scanning from the input not yet consumed.
+     *
+     * If the scanned value (or the value that failed to scan) may continue in
+     * the next chunk, `error::need_more_input` is returned instead, and no
+     * input is consumed (although the arguments may have been written to):
+     * the same call can be retried after the next `feed()`.
+     * This is the case when:
+     *  - the input ran out (`error::end_of_range`), or
+     *  - the value read, or the value that failed to scan, ends at the end of
+     *    the input, without any whitespace after it.
+     *
+     * A successful `scan()` with a format string ending in a literal other
+     * than whitespace or `}` (like `"{};"`) is complete once that literal has
+     * been matched, even at the end of the input.
+     * A format string ending in a replacement field (or an escaped `}}`)
+     * needs whitespace after the value, more input, or `finish()`.
+     *
+     * After the last chunk, call `finish()`, after which values at the end of
+     * the input are accepted, and `error::end_of_range` is returned again.
+     *
+     * Records already scanned are never re-scanned: only a record cut off at
+     * the end of a chunk is retried.
+     * Chunks are not copied if they're consumed before the next `feed()`.
+     * Otherwise, the unconsumed tail is copied into an internal buffer, and
+     * later chunks are appended to it, until it's consumed.
+     * Thus, a chunk, and any `string_view`s scanned from it, must stay valid
+     * until the next call to `feed()` has returned.
+     */
+    template <typename CharT>
+    class basic_push_scanner {
+    public:
+        using char_type = CharT;
+        using view_type = basic_string_view<CharT>;
+
+        basic_push_scanner() = default;
+
+        /// Gives the next chunk of input to the scanner
+        void feed(view_type chunk)
+        {
+            SCN_EXPECT(!m_finished);
+            auto rest = pending();
+            if (rest.empty()) {
+                m_buffer.clear();
+                m_input = chunk;
+                m_pos = 0;
+                m_borrowed = true;
+                return;
+            }
+            if (chunk.empty()) {
+                return;
+            }
+
+            if (m_borrowed) {
+                m_buffer.assign(rest.data(), rest.size());
+                m_borrowed = false;
+            }
+            else {
+                m_buffer.erase(0, m_pos);
+            }
+            m_buffer.append(chunk.data(), chunk.size());
+            m_pos = 0;
+        }
+
+        /// Marks the end of the input: no more calls to `feed()` can follow
+        void finish() noexcept
+        {
+            m_finished = true;
+        }
+        /// Returns `true`, if `finish()` has been called
+        SCN_NODISCARD bool finished() const noexcept
+        {
+            return m_finished;
+        }
+
+        /// Input given to `feed()`, but not yet consumed
+        SCN_NODISCARD view_type pending() const noexcept
+        {
+            // Not stored as a view to m_buffer, so that copying or moving
+            // *this doesn't leave it dangling
+            auto input =
+                m_borrowed ? m_input
+                           : view_type{m_buffer.data(), m_buffer.size()};
+            return {input.data() + m_pos, input.size() - m_pos};
+        }
+
+        /// Equivalent to `scn::scan(pending(), f, a...)`
+        template <typename Format, typename... Args>
+        error scan(const Format& f, Args&... a)
+        {
+            auto input = pending();
+            auto ret = ::scn::scan(input, f, a...);
+            return _commit(input, ret.error(),
+                           ret.range_as_string_view().size(),
+                           _ends_in_literal(detail::to_format(f)));
+        }
+
+        /// Equivalent to `scn::scan_default(pending(), a...)`
+        template <typename... Args>
+        error scan_default(Args&... a)
+        {
+            auto input = pending();
+            auto ret = ::scn::scan_default(input, a...);
+            return _commit(input, ret.error(),
+                           ret.range_as_string_view().size(), false);
+        }
+
+        /**
+         * Equivalent to `scn::ignore_until(pending(), until)`.
+         *
+         * If `until` isn't found, all pending input is consumed, and
+         * `error::need_more_input` is returned: the call should then be
+         * repeated after the next `feed()`.
+         */
+        error ignore_until(CharT until)
+        {
+            auto input = pending();
+            if (input.empty()) {
+                return _eof();
+            }
+            auto ret = ::scn::ignore_until(input, until);
+            if (!ret) {
+                return ret.error();
+            }
+            auto remaining = ret.range_as_string_view().size();
+            m_pos += input.size() - remaining;
+            if (remaining == 0 && !m_finished) {
+                return {error::need_more_input, "Delimiter not found yet"};
+            }
+            return {};
+        }
+
+    private:
+        error _eof() const
+        {
+            if (m_finished) {
+                return {error::end_of_range, "EOF"};
+            }
+            return {error::need_more_input, "Need more input"};
+        }
+
+        // Does `f` end in a literal, other than whitespace?
+        // A trailing '}' is assumed to close a replacement field
+        static bool _ends_in_literal(view_type f)
+        {
+            if (f.empty()) {
+                return false;
+            }
+            auto ch = f[f.size() - 1];
+            return ch != CharT{'}'} && !detail::is_space(ch);
+        }
+
+        // Can the last value read (or the value that failed to be read)
+        // continue in the next chunk?
+        static bool _may_be_incomplete(view_type input,
+                                       error e,
+                                       std::size_t remaining,
+                                       bool ends_in_literal)
+        {
+            if (e.code() == error::end_of_range) {
+                return true;
+            }
+            if (!e.is_recoverable()) {
+                return false;
+            }
+            if (e) {
+                // A literal at the end of the format was matched in full
+                return remaining == 0 && !ends_in_literal &&
+                       !detail::is_space(input[input.size() - 1]);
+            }
+
+            // On failure, `input` was rolled back to before the value that
+            // failed: it was complete, if whitespace follows it
+            auto it = input.end() - remaining;
+            for (; it != input.end() && detail::is_space(*it); ++it) {
+            }
+            for (; it != input.end(); ++it) {
+                if (detail::is_space(*it)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        error _commit(view_type input,
+                      error e,
+                      std::size_t remaining,
+                      bool ends_in_literal)
+        {
+            if (input.empty()) {
+                return _eof();
+            }
+            if (!m_finished &&
+                _may_be_incomplete(input, e, remaining, ends_in_literal)) {
+                return {error::need_more_input, "Need more input"};
+            }
+            m_pos += input.size() - remaining;
+            return e;
+        }
+
+        std::basic_string<CharT> m_buffer{};
+        view_type m_input{};  // if m_borrowed
+        std::size_t m_pos{0};
+        bool m_borrowed{true};
+        bool m_finished{false};
+    };
+
+    using push_scanner = basic_push_scanner<char>;
+    using wpush_scanner = basic_push_scanner<wchar_t>;
+
+    SCN_END_NAMESPACE
+}  // namespace scn
+
+#endif  // SCN_SCAN_PUSH_H
@@ -20,6 +20,7 @@
 
 #include "../util/optional.h"
 #include "common.h"
+#include "steps.h"
 #include "vscan.h"
 
 namespace scn {
@@ -114,6 +115,46 @@ namespace scn {
             return make_scan_result<Range>(SCN_MOVE(ret));
         }
 
+        template <typename Context, typename ParseCtx>
+        error scan_direct_impl(Context& ctx, ParseCtx&)
+        {
+            ctx.range().set_rollback_point();
+            return {};
+        }
+        template <typename Context,
+                  typename ParseCtx,
+                  typename T,
+                  typename... Args>
+        error scan_direct_impl(Context& ctx,
+                               ParseCtx& pctx,
+                               T& val,
+                               Args&... a)
+        {
+            auto err = visitor_boilerplate<scanner<T>>(val, ctx, pctx);
+            if (SCN_UNLIKELY(!err)) {
+                auto rb = ctx.range().reset_to_rollback_point();
+                if (!rb) {
+                    return rb;
+                }
+                return err;
+            }
+            if (sizeof...(Args) != 0) {
+                err = run_whitespace_step(ctx, false);
+                if (SCN_UNLIKELY(!err)) {
+                    return err;
+                }
+            }
+            return scan_direct_impl(ctx, pctx, a...);
+        }
+
+        template <typename WrappedRange, typename... Args>
+        error scan_direct_boilerplate(basic_context<WrappedRange>& ctx,
+                                      Args&... a)
+        {
+            auto pctx = make_parse_context(static_cast<int>(sizeof...(Args)),
+                                           ctx.locale());
+            return scan_direct_impl(ctx, pctx, a...);
+        }
     }  // namespace detail
 
     // scan
@@ -173,12 +214,54 @@ namespace scn {
     }
 #endif
 
+    /**
+     * Equivalent to \ref scan_default, but the arguments aren't type-erased:
+     * the scanners for the types of `a` are called directly, instead of
+     * going through `basic_args` and `vscan`.
+     *
+     * This lets the compiler inline the scanning of every argument into the
+     * call site, at the cost of instantiating the scanners for every range
+     * type this function is called with. Useful for hot loops, scanning
+     * only one or two values at a time.
+     *
+     * \code{.cpp}
+     * int i;
+     * double d;
+     * scn::scan_direct("123 3.14", i, d);
+     * // i == 123, d == 3.14
+     * \endcode
+     *
+     * \see scan_default
+     */
+#if SCN_DOXYGEN
+    template <typename Range, typename... Args>
+    auto scan_direct(Range&& r, Args&... a)
+        -> detail::scan_result_for_range<Range>;
+#else
+    template <typename Range, typename... Args>
+    SCN_NODISCARD auto scan_direct(Range&& r, Args&... a)
+        -> detail::scan_result_for_range<Range>
+    {
+        static_assert(sizeof...(Args) > 0,
+                      "Have to scan at least a single argument");
+        static_assert(SCN_CHECK_CONCEPT(ranges::range<Range>),
+                      "Input needs to be a Range");
+
+        auto ctx = make_context(wrap(SCN_FWD(r)));
+        auto err = detail::scan_direct_boilerplate(ctx, a...);
+        return detail::wrap_result(wrapped_error{err},
+                                   detail::range_tag<Range>{},
+                                   SCN_MOVE(ctx.range()));
+    }
+#endif
+
     // scan localized
 
     /**
      * Read from the range in \c r using the locale in \c loc.
-     * \c loc must be a \c std::locale. The parameter is a template to avoid
-     * inclusion of `<locale>`.
+     * \c loc must be a \c std::locale, or a `basic_shared_locale`.
+     * The parameter is a template to avoid inclusion of `<locale>`.
+     * Locales are prepared once and cached, see `basic_shared_locale`.
      *
      * Use of this function is discouraged, due to the overhead involved
      * with locales. Note, that the other functions are completely
@@ -228,6 +311,9 @@ namespace scn {
      * The return type of this function is otherwise similar to other scanning
      * functions.
      *
+     * Like \ref scan_direct, doesn't type-erase the value: the scanner for `T`
+     * is called directly.
+     *
      * \code{.cpp}
      * auto ret = scn::scan_value<int>("42");
      * if (ret) {
@@ -245,17 +331,16 @@ namespace scn {
         -> detail::generic_scan_result_for_range<expected<T>, Range>
     {
         T value;
-        auto range = wrap(SCN_FWD(r));
-        auto args = make_args_for(range, 1, value);
-        auto ret = vscan_default(SCN_MOVE(range), 1, {args});
-        if (ret.err) {
+        auto ctx = make_context(wrap(SCN_FWD(r)));
+        auto err = detail::scan_direct_boilerplate(ctx, value);
+        if (err) {
             return detail::wrap_result(expected<T>{value},
                                        detail::range_tag<Range>{},
-                                       SCN_MOVE(ret.range));
+                                       SCN_MOVE(ctx.range()));
         }
-        return detail::wrap_result(expected<T>{ret.err},
+        return detail::wrap_result(expected<T>{err},
                                    detail::range_tag<Range>{},
-                                   SCN_MOVE(ret.range));
+                                   SCN_MOVE(ctx.range()));
     }
 #endif
 
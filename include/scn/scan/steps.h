@@ -0,0 +1,340 @@
+// Copyright 2017 Elias Kosunen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// This file is a part of scnlib:
+//     https://github.com/eliaskosunen/scnlib
+
+#ifndef SCN_SCAN_STEPS_H
+#define SCN_SCAN_STEPS_H
+
+#include "vscan.h"
+
+#include <algorithm>
+
+namespace scn {
+    SCN_BEGIN_NAMESPACE
+
+    namespace detail {
+        enum class compiled_step_kind : unsigned char {
+            literal,
+            whitespace,
+            argument
+        };
+
+        /**
+         * A single step of a compiled format string.
+         *
+         * For literals, `[begin, end)` are the code units to match.
+         * For arguments, `[begin, end)` is the format specifier, including
+         * the closing brace, and `arg_id` is the index of the argument.
+         */
+        struct compiled_step {
+            compiled_step_kind kind;
+            std::size_t begin;
+            std::size_t end;
+            std::size_t arg_id;
+        };
+
+        enum class format_compile_error : unsigned char {
+            none,
+            unexpected_end,
+            invalid_arg_id,
+            mixed_arg_id,
+            arg_id_out_of_range,
+            invalid_specifier
+        };
+
+        struct format_parse_result {
+            std::size_t steps;
+            std::size_t args;
+            format_compile_error error;
+        };
+
+        template <typename CharT>
+        constexpr bool is_format_space(CharT ch)
+        {
+            return ch == 0x20 || (ch >= 0x09 && ch <= 0x0d);
+        }
+        template <typename CharT>
+        constexpr bool is_format_digit(CharT ch)
+        {
+            return ch >= 0x30 && ch <= 0x39;
+        }
+
+        template <typename CharT>
+        constexpr bool is_format_align(CharT ch)
+        {
+            return ch == static_cast<CharT>('<') ||
+                   ch == static_cast<CharT>('>') ||
+                   ch == static_cast<CharT>('^');
+        }
+
+        SCN_CONSTEXPR14 void push_compiled_step(compiled_step* out,
+                                                std::size_t capacity,
+                                                std::size_t& n,
+                                                compiled_step& last,
+                                                compiled_step step)
+        {
+            if (n > 0 && step.kind == compiled_step_kind::literal &&
+                last.kind == compiled_step_kind::literal &&
+                last.end == step.begin) {
+                // Merge adjacent literals
+                last.end = step.end;
+                if (out && n <= capacity) {
+                    out[n - 1] = last;
+                }
+                return;
+            }
+            last = step;
+            if (out && n < capacity) {
+                out[n] = step;
+            }
+            ++n;
+        }
+
+        /**
+         * Split the format string `f` into steps, in the same way `visit()`
+         * would walk over it.
+         *
+         * If `out` is `nullptr`, only counts the steps. Otherwise, at most
+         * `capacity` steps are written into `out`.
+         */
+        template <typename CharT>
+        SCN_CONSTEXPR14 format_parse_result
+        parse_compiled_format(basic_string_view<CharT> f,
+                              compiled_step* out,
+                              std::size_t capacity)
+        {
+            format_parse_result res{};
+            std::size_t n = 0;
+            compiled_step last{};
+            std::ptrdiff_t next_arg_id = 0;
+
+            const auto brace_open = static_cast<CharT>('{');
+            const auto brace_close = static_cast<CharT>('}');
+            const auto colon = static_cast<CharT>(':');
+
+            std::size_t i = 0;
+            while (i < f.size()) {
+                const auto ch = f[i];
+                if (is_format_space(ch)) {
+                    while (i < f.size() && is_format_space(f[i])) {
+                        ++i;
+                    }
+                    push_compiled_step(
+                        out, capacity, n, last,
+                        {compiled_step_kind::whitespace, i, i, std::size_t{0}});
+                    continue;
+                }
+                if (ch == brace_close) {
+                    // '}' is skipped, and the character after it is read as
+                    // a literal
+                    if (i + 1 >= f.size()) {
+                        res.error = format_compile_error::unexpected_end;
+                        return res;
+                    }
+                    push_compiled_step(out, capacity, n, last,
+                                       {compiled_step_kind::literal, i + 1,
+                                        i + 2, std::size_t{0}});
+                    i += 2;
+                    continue;
+                }
+                if (ch != brace_open) {
+                    push_compiled_step(out, capacity, n, last,
+                                       {compiled_step_kind::literal, i, i + 1,
+                                        std::size_t{0}});
+                    ++i;
+                    continue;
+                }
+                if (i + 1 < f.size() && f[i + 1] == brace_open) {
+                    // "{{"
+                    push_compiled_step(out, capacity, n, last,
+                                       {compiled_step_kind::literal, i + 1,
+                                        i + 2, std::size_t{0}});
+                    i += 2;
+                    continue;
+                }
+
+                // Argument
+                if (i + 1 >= f.size()) {
+                    res.error = format_compile_error::unexpected_end;
+                    return res;
+                }
+                std::size_t spec_begin = i + 1;
+                std::size_t arg_id = 0;
+                if (f[i + 1] == brace_close || f[i + 1] == colon) {
+                    arg_id = next_arg_id >= 0
+                                 ? static_cast<std::size_t>(next_arg_id++)
+                                 : 0;
+                    if (f[i + 1] == colon) {
+                        ++spec_begin;
+                    }
+                }
+                else {
+                    auto id_end = i + 1;
+                    while (id_end < f.size() && f[id_end] != brace_close &&
+                           f[id_end] != colon) {
+                        if (!is_format_digit(f[id_end])) {
+                            res.error = format_compile_error::invalid_arg_id;
+                            return res;
+                        }
+                        arg_id = arg_id * 10 +
+                                 static_cast<std::size_t>(f[id_end] - 0x30);
+                        ++id_end;
+                    }
+                    if (id_end == f.size()) {
+                        res.error = format_compile_error::unexpected_end;
+                        return res;
+                    }
+                    if (next_arg_id > 0) {
+                        res.error = format_compile_error::mixed_arg_id;
+                        return res;
+                    }
+                    next_arg_id = -1;
+                    spec_begin = f[id_end] == colon ? id_end + 1 : id_end;
+                }
+
+                auto spec_end = spec_begin;
+                while (spec_end < f.size() && f[spec_end] != brace_close) {
+                    ++spec_end;
+                }
+                if (spec_end == f.size()) {
+                    res.error = format_compile_error::unexpected_end;
+                    return res;
+                }
+
+                push_compiled_step(out, capacity, n, last,
+                                   {compiled_step_kind::argument, spec_begin,
+                                    spec_end + 1, arg_id});
+                if (arg_id + 1 > res.args) {
+                    res.args = arg_id + 1;
+                }
+                i = spec_end + 1;
+            }
+
+            res.steps = n;
+            return res;
+        }
+
+        // Every enumerator is handled, the default is for -Wswitch-default
+        SCN_CLANG_PUSH
+        SCN_CLANG_IGNORE("-Wcovered-switch-default")
+
+        /**
+         * Convert `e` into the error `visit()` would return for the same
+         * format string.
+         */
+        inline error make_format_compile_error(format_compile_error e)
+        {
+            switch (e) {
+                case format_compile_error::none:
+                    return {};
+                case format_compile_error::unexpected_end:
+                    return {error::invalid_format_string,
+                            "Unexpected end of format string"};
+                case format_compile_error::invalid_arg_id:
+                    return {error::invalid_format_string,
+                            "Failed to parse argument id from format string"};
+                case format_compile_error::invalid_specifier:
+                    return {error::invalid_format_string,
+                            "Invalid format specifier"};
+                case format_compile_error::mixed_arg_id:
+                case format_compile_error::arg_id_out_of_range:
+                default:
+                    return {error::invalid_format_string,
+                            "Argument id out of range"};
+            }
+        }
+        SCN_CLANG_POP
+
+        /**
+         * Run a whitespace step: skip whitespace from the range.
+         * `last` is `true`, if this is the last step of the format string.
+         */
+        template <typename Context>
+        error run_whitespace_step(Context& ctx, bool last)
+        {
+            auto ret = skip_range_whitespace(ctx, false);
+            if (SCN_UNLIKELY(!ret)) {
+                if (ret == error::end_of_range) {
+                    // EOF is not an error, if the format string is exhausted
+                    if (last) {
+                        return {};
+                    }
+                    return {error::invalid_format_string,
+                            "Format string not exhausted"};
+                }
+                auto rb = ctx.range().reset_to_rollback_point();
+                if (!rb) {
+                    return rb;
+                }
+                return ret;
+            }
+            return {};
+        }
+
+        /**
+         * Run a literal step: read the code units in `lit` from the range.
+         * Compared against the buffer of the range all at once with
+         * `match_literal()`, if possible, and code point by code point
+         * otherwise.
+         */
+        template <typename Context>
+        error run_literal_step(
+            Context& ctx,
+            basic_string_view<typename Context::char_type> lit)
+        {
+            std::size_t it = 0;
+            while (it != lit.size()) {
+                auto matched = match_literal(
+                    ctx.range(), make_span(lit.data() + it, lit.size() - it));
+                if (!matched) {
+                    auto rb = ctx.range().reset_to_rollback_point();
+                    if (!rb) {
+                        return rb;
+                    }
+                    return matched.error();
+                }
+                if (matched.value() != 0) {
+                    it += matched.value();
+                    continue;
+                }
+
+                alignas(typename Context::char_type) unsigned char
+                    buf[4] = {0};
+                auto ret = read_code_point(ctx.range(), make_span(buf, 4));
+                if (!ret || ret.value().chars.size() > lit.size() - it ||
+                    !std::equal(ret.value().chars.begin(),
+                                ret.value().chars.end(), lit.data() + it)) {
+                    auto rb = ctx.range().reset_to_rollback_point();
+                    if (!rb) {
+                        return rb;
+                    }
+                    if (!ret) {
+                        return ret.error();
+                    }
+                    return {error::invalid_scanned_value,
+                            "Expected character from format string not found "
+                            "in the stream"};
+                }
+                it += ret.value().chars.size();
+            }
+            return {};
+        }
+    }  // namespace detail
+
+    SCN_END_NAMESPACE
+}  // namespace scn
+
+#endif  // SCN_SCAN_STEPS_H
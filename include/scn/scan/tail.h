@@ -0,0 +1,161 @@
+// Copyright 2017 Elias Kosunen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// This file is a part of scnlib:
+//     https://github.com/eliaskosunen/scnlib
+
+#ifndef SCN_SCAN_TAIL_H
+#define SCN_SCAN_TAIL_H
+
+#include "../detail/file.h"
+#include "push.h"
+
+#include <vector>
+
+namespace scn {
+    SCN_BEGIN_NAMESPACE
+
+    /**
+     * Follows a file, which is appended to (like a log file).
+     *
+     * Every call to `poll()` reads the data appended to the file since the
+     * last call, from the byte offset where the last call stopped, and
+     * gives it to `scanner()`.
+     * The file is not reopened, nor re-read from the start.
+     * A record cut off at the current end of the file is kept in
+     * `scanner()`, and is scanned once the rest of it has been appended,
+     * see `basic_push_scanner`.
+     *
+     * `checkpoint()` is the byte offset of the first code unit not yet
+     * consumed from `scanner()`.
+     * It can be persisted, and given to the constructor, to resume after a
+     * restart, without re-scanning the records before it.
+     *
+     * If the file has shrunk (it was truncated), it's followed again from
+     * the beginning, and any partial record is dropped.
+     *
+     * \code{.cpp}
+     * scn::tail_file log{"app.log", load_checkpoint()};
+     * while (running) {
+     *     log.poll();
+     *     while (log.scanner().scan("{} {}", level, message)) {
+     *         // ...
+     *     }
+     *     save_checkpoint(log.checkpoint());
+     *     sleep();
+     * }
+     * \endcode
+     */
+    template <typename CharT>
+    class basic_tail_file : public detail::byte_tail_file {
+    public:
+        using char_type = CharT;
+
+        /// Constructs an empty, invalid tail-file
+        basic_tail_file() = default;
+
+        /**
+         * Opens `filename`, to be followed from the byte offset
+         * `checkpoint`, returned by an earlier `checkpoint()`.
+         * At most `chunk_size` code units are read per call to `poll()`.
+         */
+        explicit basic_tail_file(const char* filename,
+                                 std::uint64_t checkpoint = 0,
+                                 std::size_t chunk_size = 65536)
+            : detail::byte_tail_file{filename},
+              m_offset{checkpoint},
+              m_chunk_size{chunk_size}
+        {
+            SCN_EXPECT(checkpoint % sizeof(CharT) == 0);
+            SCN_EXPECT(chunk_size > 0);
+        }
+
+        /// The scanner holding the data read but not yet consumed
+        basic_push_scanner<CharT>& scanner() noexcept
+        {
+            return m_scanner;
+        }
+
+        /**
+         * Reads the data appended to the file since the last call (at most
+         * the `chunk_size` given to the constructor), and gives it to
+         * `scanner()`.
+         *
+         * \return The number of code units read, `0` if the file hasn't
+         * grown.
+         */
+        expected<std::size_t> poll()
+        {
+            SCN_EXPECT(valid());
+
+            auto size = file_size();
+            if (!size) {
+                return size.error();
+            }
+            if (size.value() < m_offset) {
+                // Truncated: start over
+                m_offset = 0;
+                m_scanner = basic_push_scanner<CharT>{};
+            }
+            auto available = (size.value() - m_offset) / sizeof(CharT);
+            if (available == 0) {
+                return std::size_t{0};
+            }
+
+            // The other buffer may still be borrowed by the scanner,
+            // until the next call to feed()
+            auto& buf = m_buffers[m_next];
+            buf.resize(static_cast<std::size_t>(
+                (std::min)(available, std::uint64_t{m_chunk_size})));
+            auto n = read_at(m_offset,
+                             {reinterpret_cast<char*>(buf.data()),
+                              buf.size() * sizeof(CharT)});
+            if (!n) {
+                return n.error();
+            }
+            // Only whole code units: the rest is read again next time
+            auto units = n.value() / sizeof(CharT);
+            if (units == 0) {
+                return std::size_t{0};
+            }
+            m_scanner.feed({buf.data(), units});
+            m_offset += units * sizeof(CharT);
+            m_next ^= 1;
+            return units;
+        }
+
+        /**
+         * Byte offset of the first code unit not yet consumed from
+         * `scanner()`.
+         */
+        SCN_NODISCARD std::uint64_t checkpoint() const noexcept
+        {
+            return m_offset - m_scanner.pending().size() * sizeof(CharT);
+        }
+
+    private:
+        basic_push_scanner<CharT> m_scanner{};
+        std::vector<CharT> m_buffers[2]{};
+        std::uint64_t m_offset{0};
+        std::size_t m_chunk_size{65536};
+        unsigned m_next{0};
+    };
+
+    using tail_file = basic_tail_file<char>;
+    using tail_wfile = basic_tail_file<wchar_t>;
+
+    SCN_END_NAMESPACE
+}  // namespace scn
+
+#endif  // SCN_SCAN_TAIL_H
@@ -21,6 +21,7 @@
 #include "../detail/context.h"
 #include "../detail/file.h"
 #include "../detail/parse_context.h"
+#include "../detail/trace.h"
 #include "../detail/visitor.h"
 #include "common.h"
 
@@ -51,7 +52,10 @@ namespace scn {
         {
             auto ctx = make_context(SCN_MOVE(r));
             auto pctx = make_parse_context(fmt, ctx.locale());
+            vscan_tracer<WrappedRange> tracer{
+                ctx.range(), static_cast<std::ptrdiff_t>(fmt.size())};
             auto err = visit(ctx, pctx, SCN_MOVE(args));
+            tracer.done(ctx.range(), err);
             return {err, SCN_MOVE(ctx.range())};
         }
 
@@ -64,7 +68,9 @@ namespace scn {
         {
             auto ctx = make_context(SCN_MOVE(r));
             auto pctx = make_parse_context(n_args, ctx.locale());
+            vscan_tracer<WrappedRange> tracer{ctx.range(), 0};
             auto err = visit(ctx, pctx, SCN_MOVE(args));
+            tracer.done(ctx.range(), err);
             return {err, SCN_MOVE(ctx.range())};
         }
 
@@ -79,7 +85,10 @@ namespace scn {
         {
             auto ctx = make_context(SCN_MOVE(r), SCN_MOVE(loc));
             auto pctx = make_parse_context(fmt, ctx.locale());
+            vscan_tracer<WrappedRange> tracer{
+                ctx.range(), static_cast<std::ptrdiff_t>(fmt.size())};
             auto err = visit(ctx, pctx, SCN_MOVE(args));
+            tracer.done(ctx.range(), err);
             return {err, SCN_MOVE(ctx.range())};
         }
     }  // namespace detail
@@ -195,6 +204,9 @@ namespace scn {
     SCN_VSCAN_DECLARE(std::wstring, wstring_wrapped, wstring_char);
     SCN_VSCAN_DECLARE(file&, file_ref_wrapped, file_ref_char);
     SCN_VSCAN_DECLARE(wfile&, wfile_ref_wrapped, wfile_ref_char);
+    SCN_VSCAN_DECLARE(valid_utf8_view, valid_utf8_view_wrapped,
+                      valid_utf8_view_char);
+    SCN_VSCAN_DECLARE(ascii_view, ascii_view_wrapped, ascii_view_char);
 
 #endif  // !SCN_HEADER_ONLY
 
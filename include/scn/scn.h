@@ -22,5 +22,9 @@
 #include "scan/getline.h"
 #include "scan/ignore.h"
 #include "scan/list.h"
+#include "scan/columns.h"
+#include "scan/compile.h"
+#include "scan/prepare.h"
+#include "scan/push.h"
 
 #endif  // SCN_SCN_H
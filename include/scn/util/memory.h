@@ -132,6 +132,33 @@ namespace scn {
         };
 #endif
 
+        template <typename T, typename Container>
+        auto construct_with_allocator_of_impl(const Container& c,
+                                              priority_tag<1>)
+            -> decltype(T(c.get_allocator()))
+        {
+            return T(c.get_allocator());
+        }
+        template <typename T, typename Container>
+        T construct_with_allocator_of_impl(const Container&, priority_tag<0>)
+        {
+            return T();
+        }
+
+        /**
+         * Construct a `T`, using the allocator of `c`, if `c` has one and
+         * `T` can be constructed from it. Otherwise, value-initialize a `T`.
+         *
+         * Used for values scanned on the way into `c`, so that e.g.
+         * elements of a `std::pmr::vector<std::pmr::string>` are allocated
+         * from the memory resource of the vector, not the default one.
+         */
+        template <typename T, typename Container>
+        T construct_with_allocator_of(const Container& c)
+        {
+            return construct_with_allocator_of_impl<T>(c, priority_tag<1>{});
+        }
+
         template <typename T>
         constexpr T* launder(T* p) noexcept
         {
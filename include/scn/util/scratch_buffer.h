@@ -0,0 +1,128 @@
+// Copyright 2017 Elias Kosunen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// This file is a part of scnlib:
+//     https://github.com/eliaskosunen/scnlib
+
+#ifndef SCN_UTIL_SCRATCH_BUFFER_H
+#define SCN_UTIL_SCRATCH_BUFFER_H
+
+#include "../detail/fwd.h"
+#include "../detail/stats.h"
+
+#include <cstddef>
+#include <string>
+
+namespace scn {
+    SCN_BEGIN_NAMESPACE
+
+    namespace detail {
+        /**
+         * A string for the temporaries of a scanner, borrowed from a small
+         * per-thread pool for the lifetime of `*this`.
+         *
+         * The pooled strings keep their capacity between uses, so once a
+         * thread has scanned a few values, the temporaries stop allocating.
+         * Strings that grew past `max_kept_capacity` are released on return,
+         * and if the pool is exhausted (deeply nested scanners), a
+         * non-pooled string is used instead.
+         *
+         * `*this` can't be copied or moved.
+         */
+        template <typename CharT>
+        class scratch_string {
+        public:
+            using string_type = std::basic_string<CharT>;
+
+            static constexpr std::size_t pool_size = 4;
+            static constexpr std::size_t max_kept_capacity = 4096;
+
+            scratch_string()
+            {
+                auto& p = pool();
+                for (std::size_t i = 0; i != pool_size; ++i) {
+                    if (!p.in_use[i]) {
+                        p.in_use[i] = true;
+                        m_str = &p.strings[i];
+                        break;
+                    }
+                }
+                SCN_STATS_ONLY(m_initial_capacity = m_str->capacity();)
+            }
+
+            scratch_string(const scratch_string&) = delete;
+            scratch_string(scratch_string&&) = delete;
+            scratch_string& operator=(const scratch_string&) = delete;
+            scratch_string& operator=(scratch_string&&) = delete;
+
+            ~scratch_string()
+            {
+                SCN_STATS_ADD(scratch_allocations,
+                              m_str->capacity() > m_initial_capacity ? 1 : 0);
+                if (m_str == &m_own) {
+                    return;
+                }
+                auto& p = pool();
+                const auto i = static_cast<std::size_t>(m_str - p.strings);
+                SCN_EXPECT(i < pool_size && p.in_use[i]);
+                if (m_str->capacity() > max_kept_capacity) {
+                    string_type{}.swap(*m_str);
+                }
+                else {
+                    m_str->clear();
+                }
+                p.in_use[i] = false;
+            }
+
+            string_type& get() noexcept
+            {
+                return *m_str;
+            }
+            const string_type& get() const noexcept
+            {
+                return *m_str;
+            }
+
+        private:
+            struct pool_type {
+                string_type strings[pool_size]{};
+                bool in_use[pool_size]{};
+            };
+
+            static pool_type& pool()
+            {
+                SCN_CLANG_PUSH
+                SCN_CLANG_IGNORE("-Wexit-time-destructors")
+                static thread_local pool_type p;
+                SCN_CLANG_POP
+                return p;
+            }
+
+            string_type m_own{};
+            string_type* m_str{&m_own};
+#if SCN_ENABLE_STATS
+            std::size_t m_initial_capacity{0};
+#endif
+        };
+
+        template <typename CharT>
+        constexpr std::size_t scratch_string<CharT>::pool_size;
+        template <typename CharT>
+        constexpr std::size_t scratch_string<CharT>::max_kept_capacity;
+    }  // namespace detail
+
+    SCN_END_NAMESPACE
+}  // namespace scn
+
+#endif  // SCN_UTIL_SCRATCH_BUFFER_H
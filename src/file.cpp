@@ -23,6 +23,8 @@
 #include <scn/detail/file.h>
 #include <scn/util/expected.h>
 
+#include <algorithm>
+#include <cerrno>
 #include <cstdio>
 
 #if SCN_POSIX
@@ -160,6 +162,138 @@ namespace scn {
             SCN_ENSURE(!valid());
         }
 
+        SCN_FUNC byte_tail_file::byte_tail_file(const char* filename)
+        {
+#if SCN_POSIX
+            int fd = open(filename, O_RDONLY);
+            if (fd == -1) {
+                return;
+            }
+            m_file.handle = fd;
+#elif SCN_WINDOWS
+            auto f = ::CreateFileA(
+                filename, GENERIC_READ,
+                FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (f == INVALID_HANDLE_VALUE) {
+                return;
+            }
+            m_file.handle = f;
+#else
+            SCN_UNUSED(filename);
+#endif
+        }
+
+        SCN_FUNC void byte_tail_file::_destruct()
+        {
+#if SCN_POSIX
+            close(m_file.handle);
+#elif SCN_WINDOWS
+            ::CloseHandle(m_file.handle);
+#endif
+            m_file = native_file_handle::invalid();
+
+            SCN_ENSURE(!valid());
+        }
+
+        SCN_FUNC expected<std::uint64_t> byte_tail_file::file_size() const
+        {
+            SCN_EXPECT(valid());
+#if SCN_POSIX
+            struct stat s {
+            };
+            if (fstat(m_file.handle, &s) == -1) {
+                return error(error::source_error, "fstat() failed");
+            }
+            return static_cast<std::uint64_t>(s.st_size);
+#elif SCN_WINDOWS
+            LARGE_INTEGER size;
+            if (::GetFileSizeEx(m_file.handle, &size) == 0) {
+                return error(error::source_error, "GetFileSizeEx() failed");
+            }
+            return static_cast<std::uint64_t>(size.QuadPart);
+#else
+            return error(error::invalid_operation,
+                         "File size not supported on this platform");
+#endif
+        }
+
+        SCN_FUNC expected<std::size_t> byte_tail_file::read_at(
+            std::uint64_t offset,
+            span<char> buf) const
+        {
+            SCN_EXPECT(valid());
+#if SCN_POSIX
+            while (true) {
+                auto n = pread(m_file.handle, buf.data(), buf.size(),
+                               static_cast<off_t>(offset));
+                if (n >= 0) {
+                    return static_cast<std::size_t>(n);
+                }
+                if (errno != EINTR) {
+                    return error(error::source_error, "pread() failed");
+                }
+            }
+#elif SCN_WINDOWS
+            OVERLAPPED ov{};
+            ov.Offset = static_cast<DWORD>(offset & 0xffffffffull);
+            ov.OffsetHigh = static_cast<DWORD>(offset >> 32ull);
+            DWORD n{};
+            auto size = static_cast<DWORD>(
+                (std::min)(buf.size(), std::size_t{0x7fffffff}));
+            if (::ReadFile(m_file.handle, buf.data(), size, &n, &ov) == 0) {
+                if (::GetLastError() == ERROR_HANDLE_EOF) {
+                    return std::size_t{0};
+                }
+                return error(error::source_error, "ReadFile() failed");
+            }
+            return static_cast<std::size_t>(n);
+#else
+            SCN_UNUSED(offset);
+            SCN_UNUSED(buf);
+            return error(error::invalid_operation,
+                         "Reading at an offset not supported on this platform");
+#endif
+        }
+
+#if SCN_POSIX
+        // EWOULDBLOCK may or may not equal EAGAIN
+        static bool is_would_block(int e)
+        {
+#if EWOULDBLOCK != EAGAIN
+            return e == EAGAIN || e == EWOULDBLOCK;
+#else
+            return e == EAGAIN;
+#endif
+        }
+#endif
+
+        SCN_FUNC expected<std::ptrdiff_t> read_nonblocking(
+            native_file_handle fd,
+            span<char> buf)
+        {
+#if SCN_POSIX
+            while (true) {
+                auto n = ::read(fd.handle, buf.data(), buf.size());
+                if (n >= 0) {
+                    return static_cast<std::ptrdiff_t>(n);
+                }
+                if (errno == EINTR) {
+                    continue;
+                }
+                if (is_would_block(errno)) {
+                    return std::ptrdiff_t{-1};
+                }
+                return error(error::source_error, "read() failed");
+            }
+#else
+            SCN_UNUSED(fd);
+            SCN_UNUSED(buf);
+            return error(error::invalid_operation,
+                         "Non-blocking reads are not supported");
+#endif
+        }
+
     }  // namespace detail
 
     namespace detail {
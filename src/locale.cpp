@@ -20,19 +20,94 @@
 #endif
 
 #include <scn/detail/locale.h>
+#include <scn/detail/stats.h>
 #include <scn/util/math.h>
+#include <scn/util/scratch_buffer.h>
 
+#if !defined(SCN_HEADER_ONLY) || !SCN_HEADER_ONLY
+#include <scn/reader/float.h>
+#include <scn/reader/int.h>
+#endif
+
+#include <array>
+#include <atomic>
 #include <cctype>
 #include <cmath>
 #include <cwchar>
-#include <iomanip>
 #include <locale>
-#include <sstream>
+#include <mutex>
 
 namespace scn {
     SCN_BEGIN_NAMESPACE
 
     namespace detail {
+        // Two-level table of the ctype_class of BMP code points.
+        // The first page (U+0000-U+00FF) is filled when the locale is
+        // initialized, the others on first use, possibly concurrently.
+        struct code_point_class_table {
+            using page_type = std::array<uint16_t, 256>;
+
+            code_point_class_table() = default;
+            code_point_class_table(const code_point_class_table&) = delete;
+            code_point_class_table& operator=(const code_point_class_table&) =
+                delete;
+            ~code_point_class_table()
+            {
+                reset();
+            }
+
+            void reset()
+            {
+                for (auto& p : pages) {
+                    delete p.exchange(nullptr);
+                }
+            }
+
+            page_type first_page{};
+            std::atomic<page_type*> pages[256]{};
+        };
+
+        inline uint16_t to_ctype_class(std::ctype_base::mask m)
+        {
+            uint16_t cls{0};
+            const auto add = [&](std::ctype_base::mask std_cls,
+                                 uint16_t scn_cls) {
+                if ((m & std_cls) != 0) {
+                    cls = static_cast<uint16_t>(cls | scn_cls);
+                }
+            };
+            add(std::ctype_base::alnum, ctype_class::alnum);
+            add(std::ctype_base::alpha, ctype_class::alpha);
+            add(std::ctype_base::blank, ctype_class::blank);
+            add(std::ctype_base::cntrl, ctype_class::cntrl);
+            add(std::ctype_base::digit, ctype_class::digit);
+            add(std::ctype_base::graph, ctype_class::graph);
+            add(std::ctype_base::lower, ctype_class::lower);
+            add(std::ctype_base::print, ctype_class::print);
+            add(std::ctype_base::punct, ctype_class::punct);
+            add(std::ctype_base::space, ctype_class::space);
+            add(std::ctype_base::upper, ctype_class::upper);
+            add(std::ctype_base::xdigit, ctype_class::xdigit);
+            return cls;
+        }
+
+        // Classify the characters first, first + 1, ..., first + 255
+        template <typename CharT>
+        void fill_ctype_classes(std::array<uint16_t, 256>& table,
+                                const std::ctype<CharT>& facet,
+                                uint32_t first)
+        {
+            std::array<CharT, 256> chars{};
+            std::array<std::ctype_base::mask, 256> masks{};
+            for (uint32_t i = 0; i != 256; ++i) {
+                chars[i] = static_cast<CharT>(first + i);
+            }
+            facet.is(chars.data(), chars.data() + chars.size(), masks.data());
+            for (std::size_t i = 0; i != 256; ++i) {
+                table[i] = to_ctype_class(masks[i]);
+            }
+        }
+
         template <typename CharT>
         struct locale_data {
             using char_type = CharT;
@@ -45,6 +120,11 @@ namespace scn {
             string_type falsename{};
             char_type decimal_point{};
             char_type thousands_separator{};
+            std::string grouping{};
+
+            // ctype_class of every code unit value 0-255
+            std::array<uint16_t, 256> code_unit_classes{};
+            code_point_class_table code_point_classes{};
         };
 
         template <typename CharT>
@@ -84,14 +164,22 @@ namespace scn {
         template <typename CharT>
         void basic_custom_locale_ref<CharT>::_initialize()
         {
-            const auto& facet =
-                std::use_facet<std::numpunct<CharT>>(to_locale(*this));
+            const auto& locale = to_locale(*this);
+            const auto& facet = std::use_facet<std::numpunct<CharT>>(locale);
 
             auto& data = *static_cast<locale_data<CharT>*>(m_data);
             data.truename = facet.truename();
             data.falsename = facet.falsename();
             data.decimal_point = facet.decimal_point();
             data.thousands_separator = facet.thousands_sep();
+            data.grouping = facet.grouping();
+
+            fill_ctype_classes(data.code_unit_classes,
+                               std::use_facet<std::ctype<CharT>>(locale), 0);
+            fill_ctype_classes(data.code_point_classes.first_page,
+                               std::use_facet<std::ctype<wchar_t>>(locale), 0);
+            data.code_point_classes.reset();
+            m_ascii_classes = data.code_point_classes.first_page.data();
         }
 
         template <typename CharT>
@@ -143,23 +231,25 @@ namespace scn {
         {
             m_locale =
                 &static_cast<locale_data<CharT>*>(m_data)->classic_locale;
+            _initialize();
         }
         template <typename CharT>
         void basic_custom_locale_ref<CharT>::convert_to_global()
         {
             SCN_EXPECT(m_data);
             m_locale = &static_cast<locale_data<CharT>*>(m_data)->global_locale;
+            _initialize();
         }
 
         template <typename CharT>
         bool basic_custom_locale_ref<CharT>::do_is_space(char_type ch) const
         {
-            return std::isspace(ch, to_locale(*this));
+            return (classify(ch) & ctype_class::space) != 0;
         }
         template <typename CharT>
         bool basic_custom_locale_ref<CharT>::do_is_digit(char_type ch) const
         {
-            return std::isdigit(ch, to_locale(*this));
+            return (classify(ch) & ctype_class::digit) != 0;
         }
 
         template <typename CharT>
@@ -252,64 +342,101 @@ namespace scn {
         }
 
         template <typename CharT>
-        bool basic_custom_locale_ref<CharT>::do_is_space(
+        uint16_t basic_custom_locale_ref<CharT>::classify(char_type ch) const
+        {
+            const auto c =
+                static_cast<typename std::make_unsigned<CharT>::type>(ch);
+            if (c < 256) {
+                return static_cast<locale_data<CharT>*>(m_data)
+                    ->code_unit_classes[c];
+            }
+            return classify(static_cast<code_point>(c));
+        }
+        template <typename CharT>
+        uint16_t basic_custom_locale_ref<CharT>::classify(code_point cp) const
+        {
+            using page_type = code_point_class_table::page_type;
+
+            const auto c = static_cast<uint32_t>(cp);
+            auto& table =
+                static_cast<locale_data<CharT>*>(m_data)->code_point_classes;
+            if (c < 256) {
+                return table.first_page[c];
+            }
+            const auto& facet =
+                std::use_facet<std::ctype<wchar_t>>(to_locale(*this));
+            if (c > 0xffff) {
+                const auto ch = static_cast<wchar_t>(c);
+                std::ctype_base::mask m{};
+                facet.is(&ch, &ch + 1, &m);
+                return to_ctype_class(m);
+            }
+
+            auto& page_ptr = table.pages[c >> 8u];
+            auto page = page_ptr.load(std::memory_order_acquire);
+            if (!page) {
+                auto new_page = new page_type{};
+                fill_ctype_classes(*new_page, facet, c & ~0xffu);
+                if (page_ptr.compare_exchange_strong(
+                        page, new_page, std::memory_order_acq_rel,
+                        std::memory_order_acquire)) {
+                    page = new_page;
+                }
+                else {
+                    // Filled by another thread in the meantime
+                    delete new_page;
+                }
+            }
+            return (*page)[c & 0xffu];
+        }
+        template <typename CharT>
+        uint16_t basic_custom_locale_ref<CharT>::_classify(
             span<const char_type> ch) const
         {
-            const auto& locale = to_locale(*this);
+            SCN_EXPECT(ch.size() >= 1);
             if (sizeof(CharT) == 1) {
-                SCN_EXPECT(ch.size() >= 1);
                 code_point cp{};
                 auto it = parse_code_point(ch.begin(), ch.end(), cp);
                 SCN_EXPECT(it);
-                return is_space(cp);
+                return classify(cp);
             }
             SCN_EXPECT(ch.size() == 1);
-            return std::isspace(ch[0], locale);
+            return classify(ch[0]);
+        }
+
+        template <typename CharT>
+        bool basic_custom_locale_ref<CharT>::do_is_space(
+            span<const char_type> ch) const
+        {
+            return (classify(ch) & ctype_class::space) != 0;
         }
         template <typename CharT>
         bool basic_custom_locale_ref<CharT>::do_is_digit(
             span<const char_type> ch) const
         {
-            const auto& locale = to_locale(*this);
-            if (sizeof(CharT) == 1) {
-                SCN_EXPECT(ch.size() >= 1);
-                code_point cp{};
-                auto it = parse_code_point(ch.begin(), ch.end(), cp);
-                SCN_EXPECT(it);
-                return is_digit(cp);
-            }
-            SCN_EXPECT(ch.size() == 1);
-            return std::isdigit(ch[0], locale);
+            return (classify(ch) & ctype_class::digit) != 0;
         }
 
 #define SCN_DEFINE_CUSTOM_LOCALE_CTYPE(f)                                 \
     template <typename CharT>                                             \
     bool basic_custom_locale_ref<CharT>::is_##f(char_type ch) const       \
     {                                                                     \
-        return std::is##f(ch, to_locale(*this));                          \
+        return (classify(ch) & ctype_class::f) != 0;                      \
     }                                                                     \
     template <typename CharT>                                             \
     bool basic_custom_locale_ref<CharT>::is_##f(code_point cp) const      \
     {                                                                     \
-        return std::is##f(static_cast<wchar_t>(cp), to_locale(*this));    \
+        return (classify(cp) & ctype_class::f) != 0;                      \
     }                                                                     \
     template <typename CharT>                                             \
     bool basic_custom_locale_ref<CharT>::is_##f(span<const char_type> ch) \
         const                                                             \
     {                                                                     \
-        const auto& locale = to_locale(*this);                            \
-        if (sizeof(CharT) == 1) {                                         \
-            SCN_EXPECT(ch.size() >= 1);                                   \
-            code_point cp{};                                              \
-            auto it = parse_code_point(ch.begin(), ch.end(), cp);         \
-            SCN_EXPECT(it);                                               \
-            return is_##f(cp);                                            \
-        }                                                                 \
-        SCN_EXPECT(ch.size() == 1);                                       \
-        return std::is##f(ch[0], locale);                                 \
+        return (classify(ch) & ctype_class::f) != 0;                      \
     }
         SCN_DEFINE_CUSTOM_LOCALE_CTYPE(alnum)
         SCN_DEFINE_CUSTOM_LOCALE_CTYPE(alpha)
+        SCN_DEFINE_CUSTOM_LOCALE_CTYPE(blank)
         SCN_DEFINE_CUSTOM_LOCALE_CTYPE(cntrl)
         SCN_DEFINE_CUSTOM_LOCALE_CTYPE(graph)
         SCN_DEFINE_CUSTOM_LOCALE_CTYPE(lower)
@@ -322,217 +449,377 @@ namespace scn {
         template <typename CharT>
         bool basic_custom_locale_ref<CharT>::is_space(code_point cp) const
         {
-            return std::isspace(static_cast<wchar_t>(cp), to_locale(*this));
+            return (classify(cp) & ctype_class::space) != 0;
         }
         template <typename CharT>
         bool basic_custom_locale_ref<CharT>::is_digit(code_point cp) const
         {
-            return std::isdigit(static_cast<wchar_t>(cp), to_locale(*this));
+            return (classify(cp) & ctype_class::digit) != 0;
         }
 
-        // For some reason, there's no isblank in libc++
         template <typename CharT>
-        bool basic_custom_locale_ref<CharT>::is_blank(char_type ch) const
+        bool is_localized_digit(CharT ch, int base)
         {
-            return std::use_facet<std::ctype<CharT>>(to_locale(*this))
-                .is(std::ctype_base::blank, ch);
+            if (ch >= ascii_widen<CharT>('0') &&
+                ch <= ascii_widen<CharT>('9')) {
+                return base != 8 || ch <= ascii_widen<CharT>('7');
+            }
+            if (base == 16) {
+                return (ch >= ascii_widen<CharT>('a') &&
+                        ch <= ascii_widen<CharT>('f')) ||
+                       (ch >= ascii_widen<CharT>('A') &&
+                        ch <= ascii_widen<CharT>('F'));
+            }
+            return false;
         }
+
+        // Checks the digit groups in [begin, end), separated by `sep`,
+        // against `std::numpunct::grouping()`, like `std::num_get` does.
+        // Groups are counted from the right; the last group size in
+        // `grouping` repeats, and a size <= 0 or == CHAR_MAX means the
+        // group is unlimited.
         template <typename CharT>
-        bool basic_custom_locale_ref<CharT>::is_blank(code_point ch) const
-        {
-            return std::use_facet<std::ctype<wchar_t>>(to_locale(*this))
-                .is(std::ctype_base::blank, static_cast<wchar_t>(ch));
+        bool check_localized_grouping(const CharT* begin,
+                                      const CharT* end,
+                                      CharT sep,
+                                      const std::string& grouping)
+        {
+            std::size_t group = 0;
+            auto group_size = [&]() -> std::size_t {
+                auto g = static_cast<int>(grouping[group]);
+                if (g <= 0 || g == std::numeric_limits<char>::max()) {
+                    return std::numeric_limits<std::size_t>::max();
+                }
+                return static_cast<std::size_t>(g);
+            };
+
+            std::size_t count = 0;
+            for (auto it = end; it != begin; --it) {
+                if (*(it - 1) != sep) {
+                    ++count;
+                    continue;
+                }
+                if (count != group_size()) {
+                    return false;
+                }
+                count = 0;
+                if (group + 1 < grouping.size()) {
+                    ++group;
+                }
+            }
+            return count != 0 && count <= group_size();
         }
+
+        // A localized number, rewritten into the classic "C" form accepted
+        // by the regular number parsers: thousands separators removed and
+        // the decimal point replaced with '.'.
         template <typename CharT>
-        bool basic_custom_locale_ref<CharT>::is_blank(
-            span<const char_type> ch) const
-        {
-            const auto& locale = to_locale(*this);
-            if (sizeof(CharT) == 1) {
-                SCN_EXPECT(ch.size() >= 1);
-                code_point cp{};
-                auto it = parse_code_point(ch.begin(), ch.end(), cp);
-                SCN_EXPECT(it);
-                return is_blank(cp);
+        struct localized_number {
+            explicit localized_number(std::basic_string<CharT>& s) : str(s) {}
+
+            std::basic_string<CharT>& str;
+            // Number of characters in `str` before which separators were
+            // removed, and how many of them
+            std::size_t grouped_end{0};
+            std::size_t separators{0};
+
+            // Maps a position in `str` back to the original buffer
+            std::ptrdiff_t original_position(const CharT* buf,
+                                             std::size_t n,
+                                             CharT sep) const
+            {
+                if (n >= grouped_end) {
+                    return static_cast<std::ptrdiff_t>(n + separators);
+                }
+                std::size_t i = 0;
+                for (; n != 0; ++i) {
+                    if (buf[i] != sep) {
+                        --n;
+                    }
+                }
+                return static_cast<std::ptrdiff_t>(i);
             }
-            SCN_EXPECT(ch.size() == 1);
-            return std::use_facet<std::ctype<CharT>>(locale).is(
-                std::ctype_base::blank, ch[0]);
-        }
+        };
 
-        template <typename T>
-        auto read_num_check_range(T val) ->
-            typename std::enable_if<std::is_integral<T>::value, error>::type
-        {
-            if (val == std::numeric_limits<T>::max()) {
-                return error(error::value_out_of_range,
-                             "Scanned number out of range: overflow");
+        template <typename CharT>
+        error make_localized_number(localized_number<CharT>& num,
+                                    const locale_data<CharT>& data,
+                                    const std::basic_string<CharT>& buf,
+                                    int base,
+                                    bool is_float)
+        {
+            const auto sep = data.thousands_separator;
+            const auto point = data.decimal_point;
+            const bool allow_sep = !data.grouping.empty();
+            auto digit_base = base == 0 ? 10 : base;
+            auto& str = num.str;
+            str.reserve(buf.size());
+
+            std::size_t i = 0;
+            if (i < buf.size() && (buf[i] == ascii_widen<CharT>('-') ||
+                                   buf[i] == ascii_widen<CharT>('+'))) {
+                str.push_back(buf[i]);
+                ++i;
+            }
+
+            // Hex floats, infinities and NaNs: no grouping
+            const bool grouped =
+                !is_float || i == buf.size() ||
+                (buf[i] != ascii_widen<CharT>('i') &&
+                 buf[i] != ascii_widen<CharT>('I') &&
+                 buf[i] != ascii_widen<CharT>('n') &&
+                 buf[i] != ascii_widen<CharT>('N') &&
+                 !(buf[i] == ascii_widen<CharT>('0') && i + 1 < buf.size() &&
+                   (buf[i + 1] == ascii_widen<CharT>('x') ||
+                    buf[i + 1] == ascii_widen<CharT>('X'))));
+
+            if (grouped) {
+                if (base == 0 && !is_float && i < buf.size() &&
+                    buf[i] == ascii_widen<CharT>('0')) {
+                    // Base prefix: let the integer parser detect it
+                    str.push_back(buf[i]);
+                    ++i;
+                    if (i < buf.size() && (buf[i] == ascii_widen<CharT>('x') ||
+                                           buf[i] == ascii_widen<CharT>('X'))) {
+                        str.push_back(buf[i]);
+                        ++i;
+                        digit_base = 16;
+                    }
+                    else {
+                        digit_base = 8;
+                    }
+                }
+                const auto digits_begin = i;
+                for (; i < buf.size(); ++i) {
+                    const auto ch = buf[i];
+                    if (is_localized_digit(ch, digit_base)) {
+                        str.push_back(ch);
+                        continue;
+                    }
+                    if (allow_sep && ch == sep && i != digits_begin &&
+                        buf[i - 1] != sep && i + 1 < buf.size() &&
+                        is_localized_digit(buf[i + 1], digit_base)) {
+                        ++num.separators;
+                        continue;
+                    }
+                    break;
+                }
+                if (num.separators != 0 &&
+                    !check_localized_grouping(buf.data() + digits_begin,
+                                              buf.data() + i, sep,
+                                              data.grouping)) {
+                    return {error::invalid_scanned_value,
+                            "Invalid digit grouping in localized number"};
+                }
+                num.grouped_end = str.size();
+                if (!is_float) {
+                    return {};
+                }
             }
-            if (val == std::numeric_limits<T>::min()) {
-                return error(error::value_out_of_range,
-                             "Scanned number out of range: underflow");
+
+            // Rest of a floating-point number: fraction and exponent.
+            // Copied one-to-one, so that positions can be mapped back.
+            bool seen_point = false;
+            for (; i < buf.size(); ++i) {
+                auto ch = buf[i];
+                if (ch == point) {
+                    if (seen_point) {
+                        break;
+                    }
+                    seen_point = true;
+                    ch = ascii_widen<CharT>('.');
+                }
+                else if (ch == ascii_widen<CharT>('.') ||
+                         (allow_sep && ch == sep)) {
+                    break;
+                }
+                str.push_back(ch);
             }
-            return error(error::invalid_scanned_value,
-                         "Localized number read failed");
+            return {};
         }
-        template <typename T>
-        auto read_num_check_range(T val) ->
-            typename std::enable_if<std::is_floating_point<T>::value,
-                                    error>::type
-        {
-            SCN_GCC_COMPAT_PUSH
-            SCN_GCC_COMPAT_IGNORE("-Wfloat-equal")
-            if (val == std::numeric_limits<T>::max() ||
-                val == -std::numeric_limits<T>::max()) {
-                return error(error::value_out_of_range,
-                             "Scanned number out of range: overflow");
+
+        template <typename T, typename CharT>
+        expected<std::size_t> read_localized_number(
+            T& val,
+            const std::basic_string<CharT>& str,
+            int base,
+            std::false_type)
+        {
+            auto s = simple_integer_scanner<T>{};
+            auto ret = s.scan(make_span(str.data(), str.size()).as_const(),
+                              val, base);
+            if (!ret) {
+                return ret.error();
             }
-            if (val == zero_value<T>::value) {
-                return error(error::value_out_of_range,
-                             "Scanned number out of range: underflow");
+            return static_cast<std::size_t>(ret.value() - str.data());
+        }
+        template <typename T, typename CharT>
+        expected<std::size_t> read_localized_number(
+            T& val,
+            const std::basic_string<CharT>& str,
+            int,
+            std::true_type)
+        {
+            auto s = float_scanner_access<T>{};
+            std::size_t chars{};
+            SCN_CLANG_PUSH_IGNORE_UNDEFINED_TEMPLATE
+            auto ret = s._read_float_impl(str.c_str(), chars,
+                                          ascii_widen<CharT>('.'));
+            SCN_CLANG_POP_IGNORE_UNDEFINED_TEMPLATE
+            if (!ret) {
+                return ret.error();
             }
-            SCN_GCC_COMPAT_POP
-            return error(error::invalid_scanned_value,
-                         "Localized number read failed");
+            val = ret.value();
+            return chars;
         }
 
         template <typename T, typename CharT>
-        error do_read_num_impl(T& val, std::basic_istringstream<CharT>& ss)
-        {
-            ss >> val;
-            return {};
-        }
-        template <typename CharT>
-        error do_read_num_impl(CharT& val, std::basic_istringstream<CharT>& ss)
+        expected<std::ptrdiff_t> do_read_num(
+            T& val,
+            const locale_data<CharT>& data,
+            const std::basic_string<CharT>& buf,
+            int base)
         {
-            long long tmp;
-            if (!(ss >> tmp)) {
-                return {};
+            using is_float = std::is_floating_point<T>;
+
+            scratch_string<CharT> str{};
+            localized_number<CharT> num{str.get()};
+            auto e =
+                make_localized_number(num, data, buf, base, is_float::value);
+            if (!e) {
+                return e;
             }
-            if (tmp > std::numeric_limits<CharT>::max()) {
-                return {error::value_out_of_range,
-                        "Scanned number out of range: overflow"};
+            if (num.str.empty()) {
+                return error(error::invalid_scanned_value,
+                             "Localized number read failed");
             }
-            if (tmp < std::numeric_limits<CharT>::min()) {
-                return {error::value_out_of_range,
-                        "Scanned number out of range: underflow"};
+
+            T tmp{};
+            auto ret = read_localized_number(tmp, num.str, base, is_float{});
+            if (!ret) {
+                return ret.error();
             }
-            val = static_cast<CharT>(tmp);
-            return {};
+            val = tmp;
+            return num.original_position(buf.data(), ret.value(),
+                                         data.thousands_separator);
         }
+
         template <typename CharT>
-        error do_read_num_impl(signed char& val,
-                               std::basic_istringstream<CharT>& ss)
+        template <typename T>
+        expected<std::ptrdiff_t> basic_custom_locale_ref<CharT>::read_num(
+            T& val,
+            const string_type& buf,
+            int b) const
         {
-            int tmp;
-            if (!(ss >> tmp)) {
-                return {};
-            }
-            if (tmp > std::numeric_limits<signed char>::max()) {
-                return {error::value_out_of_range,
-                        "Scanned number out of range: overflow"};
-            }
-            if (tmp < std::numeric_limits<signed char>::min()) {
-                return {error::value_out_of_range,
-                        "Scanned number out of range: underflow"};
-            }
-            val = static_cast<signed char>(tmp);
-            return {};
+            SCN_STATS_ADD(localized_reads, 1);
+            return do_read_num<T, CharT>(
+                val, *static_cast<const locale_data<CharT>*>(m_data), buf, b);
         }
+
         template <typename CharT>
-        error do_read_num_impl(unsigned char& val,
-                               std::basic_istringstream<CharT>& ss)
-        {
-            int tmp;
-            if (!(ss >> tmp)) {
-                return {};
+        struct shared_locale_node {
+            explicit shared_locale_node(const std::locale& l)
+                : locale(l), custom(&locale)
+            {
             }
-            if (tmp > std::numeric_limits<unsigned char>::max()) {
-                return {error::value_out_of_range,
-                        "Scanned number out of range: overflow"};
-            }
-            if (tmp < 0) {
-                return {error::value_out_of_range,
-                        "Scanned number out of range: underflow"};
-            }
-            val = static_cast<unsigned char>(tmp);
-            return {};
-        }
 
-        SCN_GCC_PUSH
-        SCN_GCC_IGNORE("-Wmaybe-uninitialized")
+            std::atomic<long> refcount{1};
+            std::locale locale;
+            const basic_custom_locale_ref<CharT> custom;
+        };
 
-        template <typename T, typename CharT>
-        expected<std::ptrdiff_t> do_read_num(
-            T& val,
-            const std::locale& loc,
-            const std::basic_string<CharT>& buf,
-            int base)
-        {
-#if SCN_HAS_EXCEPTIONS
-            std::basic_istringstream<CharT> ss(buf);
-            ss.imbue(loc);
-            ss >> std::setbase(base);
-
-            try {
-                T tmp;
-                auto e = do_read_num_impl(tmp, ss);
-                if (ss.bad()) {
-                    return error(error::unrecoverable_internal_error,
-                                 "Localized stringstream is bad");
-                }
-                if (!e) {
-                    return e;
+        // Process-wide cache of prepared locales, keyed by std::locale
+        // identity. Holds a reference to each node; when full, the oldest
+        // entry is dropped, but stays alive while handles to it remain.
+        template <typename CharT>
+        struct shared_locale_cache {
+            using node_type = shared_locale_node<CharT>;
+
+            static shared_locale_cache& get()
+            {
+                static shared_locale_cache cache;
+                return cache;
+            }
+
+            ~shared_locale_cache()
+            {
+                for (auto n : nodes) {
+                    if (n) {
+                        release_shared_locale(n);
+                    }
                 }
-                if (ss.fail()) {
-                    return read_num_check_range(tmp);
+            }
+
+            // Returns a new reference to the node for `loc`, or nullptr.
+            // `mutex` must be held.
+            node_type* find(const std::locale& loc)
+            {
+                for (auto n : nodes) {
+                    if (n && n->locale == loc) {
+                        retain_shared_locale(n);
+                        return n;
+                    }
                 }
-                val = tmp;
+                return nullptr;
             }
-            catch (const std::ios_base::failure& f) {
-                return error(error::invalid_scanned_value, f.what());
+
+            std::mutex mutex{};
+            std::array<node_type*, 8> nodes{};
+            std::size_t next{0};
+        };
+
+        template <typename CharT>
+        shared_locale_node<CharT>* acquire_shared_locale(const void* locale)
+        {
+            SCN_EXPECT(locale);
+            const auto& loc = *static_cast<const std::locale*>(locale);
+            auto& cache = shared_locale_cache<CharT>::get();
+            {
+                std::lock_guard<std::mutex> lock{cache.mutex};
+                if (auto n = cache.find(loc)) {
+                    return n;
+                }
             }
-            return ss.eof() ? static_cast<std::ptrdiff_t>(buf.size())
-                            : static_cast<std::ptrdiff_t>(ss.tellg());
-#else
-            SCN_UNUSED(val);
-            SCN_UNUSED(loc);
-            SCN_UNUSED(buf);
-            return error(error::exceptions_required,
-                         "Localized number reading is only supported with "
-                         "exceptions enabled");
-#endif
-        }
 
-        SCN_GCC_POP
+            // Reading the facets is the expensive part:
+            // do it without holding the lock
+            auto node = new shared_locale_node<CharT>{loc};
 
-        template <>
-        expected<std::ptrdiff_t> do_read_num(wchar_t&,
-                                             const std::locale&,
-                                             const std::string&,
-                                             int)
+            std::lock_guard<std::mutex> lock{cache.mutex};
+            if (auto n = cache.find(loc)) {
+                // Prepared by another thread in the meantime
+                release_shared_locale(node);
+                return n;
+            }
+            auto& slot = cache.nodes[cache.next];
+            if (slot) {
+                release_shared_locale(slot);
+            }
+            retain_shared_locale(node);
+            slot = node;
+            cache.next = (cache.next + 1) % cache.nodes.size();
+            return node;
+        }
+        template <typename CharT>
+        void retain_shared_locale(shared_locale_node<CharT>* node)
         {
-            SCN_EXPECT(false);
-            SCN_UNREACHABLE;
+            SCN_EXPECT(node);
+            node->refcount.fetch_add(1, std::memory_order_relaxed);
         }
-        template <>
-        expected<std::ptrdiff_t> do_read_num(char&,
-                                             const std::locale&,
-                                             const std::wstring&,
-                                             int)
+        template <typename CharT>
+        void release_shared_locale(shared_locale_node<CharT>* node)
         {
-            SCN_EXPECT(false);
-            SCN_UNREACHABLE;
+            SCN_EXPECT(node);
+            if (node->refcount.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                delete node;
+            }
         }
-
         template <typename CharT>
-        template <typename T>
-        expected<std::ptrdiff_t> basic_custom_locale_ref<CharT>::read_num(
-            T& val,
-            const string_type& buf,
-            int b) const
+        const basic_custom_locale_ref<CharT>& get_shared_locale(
+            shared_locale_node<CharT>* node)
         {
-            return do_read_num<T, CharT>(val, to_locale(*this), buf, b);
+            SCN_EXPECT(node);
+            return node->custom;
         }
 
 #if SCN_INCLUDE_SOURCE_DEFINITIONS
@@ -544,6 +831,19 @@ namespace scn {
         template class basic_custom_locale_ref<wchar_t>;
         SCN_CLANG_POP
 
+        template shared_locale_node<char>* acquire_shared_locale<char>(
+            const void*);
+        template shared_locale_node<wchar_t>* acquire_shared_locale<wchar_t>(
+            const void*);
+        template void retain_shared_locale(shared_locale_node<char>*);
+        template void retain_shared_locale(shared_locale_node<wchar_t>*);
+        template void release_shared_locale(shared_locale_node<char>*);
+        template void release_shared_locale(shared_locale_node<wchar_t>*);
+        template const basic_custom_locale_ref<char>& get_shared_locale(
+            shared_locale_node<char>*);
+        template const basic_custom_locale_ref<wchar_t>& get_shared_locale(
+            shared_locale_node<wchar_t>*);
+
         template expected<std::ptrdiff_t>
         basic_custom_locale_ref<char>::read_num<signed char>(signed char&,
                                                              const string_type&,
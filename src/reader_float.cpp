@@ -20,6 +20,7 @@
 #endif
 
 #include <scn/detail/args.h>
+#include <scn/detail/trace.h>
 #include <scn/reader/float.h>
 
 #include <cerrno>
@@ -82,6 +83,9 @@ namespace scn {
                              size_t& chars,
                              uint8_t options)
             {
+                SCN_STATS_ADD(strtod_fallbacks, 1);
+                SCN_TRACE_PROBE2(float__strtod, str,
+                                 static_cast<int>(sizeof(CharT)));
 #if !SCN_USE_STATIC_LOCALE
                 // Get current C locale
                 const auto loc = std::setlocale(LC_NUMERIC, nullptr);
@@ -216,6 +220,8 @@ namespace scn {
                                        size_t& chars,
                                        uint8_t options)
                 {
+                    SCN_STATS_ADD(from_chars_fallbacks, 1);
+                    SCN_TRACE_PROBE1(float__from_chars, str);
                     const auto len = std::strlen(str);
                     std::chars_format flags{};
                     if (((options & detail::float_scanner<T>::allow_hex) !=
@@ -409,7 +415,7 @@ namespace scn {
         expected<T> float_scanner<T>::_read_float_impl(
             const CharT* str,
             size_t& chars,
-            CharT locale_decimal_point)
+            CharT locale_decimal_point) const
         {
             // Parsing algorithm to use:
             // If CharT == wchar_t -> strtod
@@ -427,25 +433,29 @@ namespace scn {
 #if SCN_INCLUDE_SOURCE_DEFINITIONS
 
         template expected<float>
-        float_scanner<float>::_read_float_impl(const char*, size_t&, char);
+        float_scanner<float>::_read_float_impl(const char*,
+                                               size_t&,
+                                               char) const;
         template expected<double>
-        float_scanner<double>::_read_float_impl(const char*, size_t&, char);
+        float_scanner<double>::_read_float_impl(const char*,
+                                                size_t&,
+                                                char) const;
         template expected<long double>
         float_scanner<long double>::_read_float_impl(const char*,
                                                      size_t&,
-                                                     char);
+                                                     char) const;
         template expected<float> float_scanner<float>::_read_float_impl(
             const wchar_t*,
             size_t&,
-            wchar_t);
+            wchar_t) const;
         template expected<double> float_scanner<double>::_read_float_impl(
             const wchar_t*,
             size_t&,
-            wchar_t);
+            wchar_t) const;
         template expected<long double>
         float_scanner<long double>::_read_float_impl(const wchar_t*,
                                                      size_t&,
-                                                     wchar_t);
+                                                     wchar_t) const;
 #endif
     }  // namespace detail
 
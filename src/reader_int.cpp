@@ -151,7 +151,7 @@ namespace scn {
         template <typename CharT>
         expected<std::ptrdiff_t> integer_scanner<T>::_parse_int(
             T& val,
-            span<const CharT> s)
+            span<const CharT> s) const
         {
             SCN_EXPECT(s.size() > 0);
 
@@ -193,6 +193,11 @@ namespace scn {
                              "Expected number after sign");
             }
 
+            const auto sign_end = it;
+
+            // Detected base only used for this value
+            int value_base{base};
+
             // Format string was 'i' or empty -> detect base
             // or
             // allow_base_prefix (skip 0x etc.)
@@ -213,7 +218,7 @@ namespace scn {
                                  "Invalid base prefix");
                 }
                 if (base == 0) {
-                    base = static_cast<uint8_t>(b);
+                    value_base = b;
                 }
                 it = r.value();
             }
@@ -228,18 +233,31 @@ namespace scn {
             SCN_CLANG_IGNORE("-Wsign-conversion")
             SCN_CLANG_IGNORE("-Wsign-compare")
 
-            SCN_ASSUME(base > 0);
+            SCN_ASSUME(value_base > 0);
 
             SCN_CLANG_PUSH_IGNORE_UNDEFINED_TEMPLATE
-            auto r = _parse_int_impl(tmp, minus_sign, make_span(it, s.end()));
+            auto r = _parse_int_impl(tmp, minus_sign, value_base,
+                                     make_span(it, s.end()));
             SCN_CLANG_POP_IGNORE_UNDEFINED_TEMPLATE
             if (!r) {
                 return r.error();
             }
-            it = r.value();
-            if (s.begin() == it) {
-                return error(error::invalid_scanned_value, "custom::read_int");
+            if (r.value() == it) {
+                if (it != sign_end) {
+                    // Only a base prefix (0x, 0b, 0o) was read:
+                    // read the '0', and leave the rest
+                    val = 0;
+                    return ranges::distance(s.begin(), sign_end) + 1;
+                }
+                if (sign_end == s.begin()) {
+                    return error(error::invalid_scanned_value,
+                                 "custom::read_int");
+                }
+                // No digits after the sign, e.g. "- 1"
+                return error(error::invalid_scanned_value,
+                             "Expected number after sign");
             }
+            it = r.value();
             val = tmp;
             return ranges::distance(s.begin(), it);
 
@@ -252,6 +270,7 @@ namespace scn {
         expected<typename span<const CharT>::iterator>
         integer_scanner<T>::_parse_int_impl(T& val,
                                             bool minus_sign,
+                                            int value_base,
                                             span<const CharT> buf) const
         {
             SCN_GCC_PUSH
@@ -271,7 +290,7 @@ namespace scn {
 
             using utype = typename std::make_unsigned<T>::type;
 
-            const auto ubase = static_cast<utype>(base);
+            const auto ubase = static_cast<utype>(value_base);
             SCN_ASSUME(ubase > 0);
 
             constexpr auto uint_max = static_cast<utype>(-1);
@@ -340,9 +359,10 @@ namespace scn {
 
 #define SCN_DEFINE_INTEGER_SCANNER_MEMBERS_IMPL(CharT, T)             \
     template expected<std::ptrdiff_t> integer_scanner<T>::_parse_int( \
-        T& val, span<const CharT> s);                                 \
+        T& val, span<const CharT> s) const;                           \
     template expected<typename span<const CharT>::iterator>           \
     integer_scanner<T>::_parse_int_impl(T& val, bool minus_sign,      \
+                                        int value_base,               \
                                         span<const CharT> buf) const; \
     template expected<typename span<const CharT>::iterator>           \
     integer_scanner<T>::parse_base_prefix(span<const CharT>, int&) const;
@@ -0,0 +1,441 @@
+// Copyright 2017 Elias Kosunen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// This file is a part of scnlib:
+//     https://github.com/eliaskosunen/scnlib
+
+#if defined(SCN_HEADER_ONLY) && SCN_HEADER_ONLY
+#define SCN_SIMD_CPP
+#endif
+
+#include <scn/detail/simd.h>
+
+#include <atomic>
+#include <cstdint>
+
+#if (SCN_GCC || SCN_CLANG) && (defined(__x86_64__) || defined(__i386__))
+#define SCN_HAS_X86_SIMD_DISPATCH 1
+#include <immintrin.h>
+#else
+#define SCN_HAS_X86_SIMD_DISPATCH 0
+#endif
+
+namespace scn {
+    SCN_BEGIN_NAMESPACE
+
+    namespace detail {
+        namespace simd {
+            inline bool is_classic_space(char ch)
+            {
+                return ch == ' ' || static_cast<unsigned char>(ch - '\t') <= 4;
+            }
+
+            static inline const char* scalar_space(const char* b,
+                                                    const char* e)
+            {
+                for (; b != e && !is_classic_space(*b); ++b) {
+                }
+                return b;
+            }
+            static inline const char* scalar_nonspace(const char* b,
+                                                       const char* e)
+            {
+                for (; b != e && is_classic_space(*b); ++b) {
+                }
+                return b;
+            }
+            static inline const char* scalar_char(const char* b,
+                                                  const char* e,
+                                                  char ch)
+            {
+                for (; b != e && *b != ch; ++b) {
+                }
+                return b;
+            }
+            static inline const char* scalar_non_ascii(const char* b,
+                                                        const char* e)
+            {
+                for (; b != e && static_cast<unsigned char>(*b) < 0x80; ++b) {
+                }
+                return b;
+            }
+
+            struct kernels {
+                simd_level level;
+                const char* (*space)(const char*, const char*);
+                const char* (*nonspace)(const char*, const char*);
+                const char* (*find_char)(const char*, const char*, char);
+                const char* (*non_ascii)(const char*, const char*);
+            };
+
+#if SCN_HAS_X86_SIMD_DISPATCH
+
+            // Every level defines, for a block of `block_size` bytes at `p`,
+            // a bitmask of the bytes that are spaces, equal to `ch`, or
+            // non-ASCII. SCN_SIMD_DEFINE_KERNELS then generates the
+            // loops over whole blocks, finishing with the scalar versions.
+
+#define SCN_SIMD_DEFINE_KERNELS(level, target_list)                           \
+    __attribute__((target(target_list))) static inline const char*            \
+        level##_space(const char* b, const char* e)                           \
+    {                                                                         \
+        for (; e - b >= level##_block_size; b += level##_block_size) {        \
+            if (auto m = level##_space_mask(b)) {                             \
+                return b + __builtin_ctzll(m);                                \
+            }                                                                 \
+        }                                                                     \
+        return scalar_space(b, e);                                            \
+    }                                                                         \
+    __attribute__((target(target_list))) static inline const char*            \
+        level##_nonspace(const char* b, const char* e)                        \
+    {                                                                         \
+        for (; e - b >= level##_block_size; b += level##_block_size) {        \
+            if (auto m = ~level##_space_mask(b) & level##_full_mask) {        \
+                return b + __builtin_ctzll(m);                                \
+            }                                                                 \
+        }                                                                     \
+        return scalar_nonspace(b, e);                                         \
+    }                                                                         \
+    __attribute__((target(target_list))) static inline const char*            \
+        level##_char(const char* b, const char* e, char ch)                   \
+    {                                                                         \
+        for (; e - b >= level##_block_size; b += level##_block_size) {        \
+            if (auto m = level##_char_mask(b, ch)) {                          \
+                return b + __builtin_ctzll(m);                                \
+            }                                                                 \
+        }                                                                     \
+        return scalar_char(b, e, ch);                                         \
+    }                                                                         \
+    __attribute__((target(target_list))) static inline const char*            \
+        level##_non_ascii(const char* b, const char* e)                       \
+    {                                                                         \
+        for (; e - b >= level##_block_size; b += level##_block_size) {        \
+            if (auto m = level##_non_ascii_mask(b)) {                         \
+                return b + __builtin_ctzll(m);                                \
+            }                                                                 \
+        }                                                                     \
+        return scalar_non_ascii(b, e);                                        \
+    }
+
+            // SSE2
+
+            static constexpr std::ptrdiff_t sse2_block_size = 16;
+            static constexpr std::uint64_t sse2_full_mask = 0xffff;
+
+            __attribute__((target("sse2"))) inline std::uint64_t
+            sse2_space_mask(const char* p)
+            {
+                const auto v =
+                    _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+                // '\t' <= ch <= '\r' <=> (ch - '\t') <= 4, unsigned
+                const auto t = _mm_sub_epi8(v, _mm_set1_epi8('\t'));
+                const auto ctrl =
+                    _mm_cmpeq_epi8(_mm_min_epu8(t, _mm_set1_epi8(4)), t);
+                const auto sp = _mm_cmpeq_epi8(v, _mm_set1_epi8(' '));
+                return static_cast<std::uint64_t>(static_cast<unsigned>(
+                    _mm_movemask_epi8(_mm_or_si128(ctrl, sp))));
+            }
+            __attribute__((target("sse2"))) inline std::uint64_t
+            sse2_char_mask(const char* p, char ch)
+            {
+                const auto v =
+                    _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+                return static_cast<std::uint64_t>(
+                    static_cast<unsigned>(_mm_movemask_epi8(
+                        _mm_cmpeq_epi8(v, _mm_set1_epi8(ch)))));
+            }
+            __attribute__((target("sse2"))) inline std::uint64_t
+            sse2_non_ascii_mask(const char* p)
+            {
+                const auto v =
+                    _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+                return static_cast<std::uint64_t>(
+                    static_cast<unsigned>(_mm_movemask_epi8(v)));
+            }
+
+            SCN_SIMD_DEFINE_KERNELS(sse2, "sse2")
+
+            // SSE4.2: spaces are found with a single pcmpestrm against the
+            // set of space characters, the rest is the same as SSE2
+
+            static constexpr std::ptrdiff_t sse42_block_size = 16;
+            static constexpr std::uint64_t sse42_full_mask = 0xffff;
+
+            __attribute__((target("sse4.2"))) inline std::uint64_t
+            sse42_space_mask(const char* p)
+            {
+                const auto set = _mm_setr_epi8(' ', '\t', '\n', '\v', '\f',
+                                               '\r', 0, 0, 0, 0, 0, 0, 0, 0,
+                                               0, 0);
+                const auto v =
+                    _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+                // Explicit lengths: the input may contain '\0'
+                const auto m = _mm_cmpestrm(
+                    set, 6, v, 16,
+                    _SIDD_UBYTE_OPS | _SIDD_CMP_EQUAL_ANY | _SIDD_BIT_MASK);
+                return static_cast<std::uint64_t>(
+                    static_cast<unsigned>(_mm_cvtsi128_si32(m)) & 0xffffu);
+            }
+            __attribute__((target("sse4.2"))) inline std::uint64_t
+            sse42_char_mask(const char* p, char ch)
+            {
+                return sse2_char_mask(p, ch);
+            }
+            __attribute__((target("sse4.2"))) inline std::uint64_t
+            sse42_non_ascii_mask(const char* p)
+            {
+                return sse2_non_ascii_mask(p);
+            }
+
+            SCN_SIMD_DEFINE_KERNELS(sse42, "sse4.2")
+
+            // AVX2
+
+            static constexpr std::ptrdiff_t avx2_block_size = 32;
+            static constexpr std::uint64_t avx2_full_mask = 0xffffffff;
+
+            __attribute__((target("avx2"))) inline std::uint64_t
+            avx2_space_mask(const char* p)
+            {
+                const auto v =
+                    _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+                const auto t = _mm256_sub_epi8(v, _mm256_set1_epi8('\t'));
+                const auto ctrl = _mm256_cmpeq_epi8(
+                    _mm256_min_epu8(t, _mm256_set1_epi8(4)), t);
+                const auto sp = _mm256_cmpeq_epi8(v, _mm256_set1_epi8(' '));
+                return static_cast<std::uint64_t>(static_cast<unsigned>(
+                    _mm256_movemask_epi8(_mm256_or_si256(ctrl, sp))));
+            }
+            __attribute__((target("avx2"))) inline std::uint64_t
+            avx2_char_mask(const char* p, char ch)
+            {
+                const auto v =
+                    _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+                return static_cast<std::uint64_t>(
+                    static_cast<unsigned>(_mm256_movemask_epi8(
+                        _mm256_cmpeq_epi8(v, _mm256_set1_epi8(ch)))));
+            }
+            __attribute__((target("avx2"))) inline std::uint64_t
+            avx2_non_ascii_mask(const char* p)
+            {
+                const auto v =
+                    _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+                return static_cast<std::uint64_t>(
+                    static_cast<unsigned>(_mm256_movemask_epi8(v)));
+            }
+
+            SCN_SIMD_DEFINE_KERNELS(avx2, "avx2")
+
+            // AVX-512 (BW)
+
+            static constexpr std::ptrdiff_t avx512_block_size = 64;
+            static constexpr std::uint64_t avx512_full_mask = ~std::uint64_t{0};
+
+            __attribute__((target("avx512f,avx512bw"))) inline std::
+                uint64_t
+                avx512_space_mask(const char* p)
+            {
+                const auto v = _mm512_loadu_si512(p);
+                const auto t = _mm512_sub_epi8(v, _mm512_set1_epi8('\t'));
+                return _mm512_cmple_epu8_mask(t, _mm512_set1_epi8(4)) |
+                       _mm512_cmpeq_epi8_mask(v, _mm512_set1_epi8(' '));
+            }
+            __attribute__((target("avx512f,avx512bw"))) inline std::
+                uint64_t
+                avx512_char_mask(const char* p, char ch)
+            {
+                const auto v = _mm512_loadu_si512(p);
+                return _mm512_cmpeq_epi8_mask(v, _mm512_set1_epi8(ch));
+            }
+            __attribute__((target("avx512f,avx512bw"))) inline std::
+                uint64_t
+                avx512_non_ascii_mask(const char* p)
+            {
+                return _mm512_movepi8_mask(_mm512_loadu_si512(p));
+            }
+
+            SCN_SIMD_DEFINE_KERNELS(avx512, "avx512f,avx512bw")
+
+#undef SCN_SIMD_DEFINE_KERNELS
+
+            static inline simd_level detect()
+            {
+                __builtin_cpu_init();
+                if (__builtin_cpu_supports("avx512bw")) {
+                    return simd_level::avx512;
+                }
+                if (__builtin_cpu_supports("avx2")) {
+                    return simd_level::avx2;
+                }
+                if (__builtin_cpu_supports("sse4.2")) {
+                    return simd_level::sse42;
+                }
+                if (__builtin_cpu_supports("sse2")) {
+                    return simd_level::sse2;
+                }
+                return simd_level::none;
+            }
+#else
+            static inline simd_level detect()
+            {
+                return simd_level::none;
+            }
+#endif  // SCN_HAS_X86_SIMD_DISPATCH
+
+            static inline const kernels& kernels_for(simd_level level)
+            {
+                static const kernels scalar_kernels = {
+                    simd_level::none, scalar_space, scalar_nonspace,
+                    scalar_char, scalar_non_ascii};
+#if SCN_HAS_X86_SIMD_DISPATCH
+                static const kernels sse2_kernels = {
+                    simd_level::sse2, sse2_space, sse2_nonspace, sse2_char,
+                    sse2_non_ascii};
+                static const kernels sse42_kernels = {
+                    simd_level::sse42, sse42_space, sse42_nonspace, sse42_char,
+                    sse42_non_ascii};
+                static const kernels avx2_kernels = {
+                    simd_level::avx2, avx2_space, avx2_nonspace, avx2_char,
+                    avx2_non_ascii};
+                static const kernels avx512_kernels = {
+                    simd_level::avx512, avx512_space, avx512_nonspace,
+                    avx512_char, avx512_non_ascii};
+#endif
+
+                switch (level) {
+#if SCN_HAS_X86_SIMD_DISPATCH
+                    case simd_level::avx512:
+                        return avx512_kernels;
+                    case simd_level::avx2:
+                        return avx2_kernels;
+                    case simd_level::sse42:
+                        return sse42_kernels;
+                    case simd_level::sse2:
+                        return sse2_kernels;
+#endif
+                    case simd_level::none:
+                    default:
+                        return scalar_kernels;
+                }
+            }
+
+            // Shared by every translation unit in header-only mode, so not
+            // static
+            SCN_FUNC std::atomic<const kernels*>& active();
+            SCN_FUNC const kernels& get();
+
+            SCN_FUNC std::atomic<const kernels*>& active()
+            {
+                static std::atomic<const kernels*> k{
+                    &kernels_for(detected_simd_level())};
+                return k;
+            }
+            SCN_FUNC const kernels& get()
+            {
+                return *active().load(std::memory_order_relaxed);
+            }
+        }  // namespace simd
+
+        SCN_FUNC simd_level detected_simd_level() noexcept
+        {
+            static const simd_level level = simd::detect();
+            return level;
+        }
+        SCN_FUNC simd_level active_simd_level() noexcept
+        {
+            return simd::get().level;
+        }
+        SCN_FUNC simd_level set_simd_level(simd_level level) noexcept
+        {
+            if (level > detected_simd_level()) {
+                level = detected_simd_level();
+            }
+            simd::active().store(&simd::kernels_for(level),
+                                 std::memory_order_relaxed);
+            return level;
+        }
+
+        SCN_FUNC const char* find_classic_space(const char* begin,
+                                                const char* end) noexcept
+        {
+            return simd::get().space(begin, end);
+        }
+        SCN_FUNC const char* find_classic_nonspace(const char* begin,
+                                                   const char* end) noexcept
+        {
+            return simd::get().nonspace(begin, end);
+        }
+        SCN_FUNC const char* find_char(const char* begin,
+                                       const char* end,
+                                       char ch) noexcept
+        {
+            return simd::get().find_char(begin, end, ch);
+        }
+        SCN_FUNC const char* find_non_ascii(const char* begin,
+                                            const char* end) noexcept
+        {
+            return simd::get().non_ascii(begin, end);
+        }
+
+        SCN_FUNC const char* find_invalid_utf8(const char* begin,
+                                               const char* end) noexcept
+        {
+            while (true) {
+                begin = find_non_ascii(begin, end);
+                if (begin == end) {
+                    return end;
+                }
+
+                const auto lead = static_cast<unsigned char>(*begin);
+                std::ptrdiff_t len{};
+                std::uint32_t cp{}, min{};
+                if ((lead >> 5) == 0x6) {
+                    len = 2;
+                    cp = lead & 0x1fu;
+                    min = 0x80;
+                }
+                else if ((lead >> 4) == 0xe) {
+                    len = 3;
+                    cp = lead & 0xfu;
+                    min = 0x800;
+                }
+                else if ((lead >> 3) == 0x1e) {
+                    len = 4;
+                    cp = lead & 0x7u;
+                    min = 0x10000;
+                }
+                else {
+                    return begin;
+                }
+                if (end - begin < len) {
+                    return begin;
+                }
+                for (std::ptrdiff_t i = 1; i < len; ++i) {
+                    const auto c = static_cast<unsigned char>(begin[i]);
+                    if ((c >> 6) != 0x2) {
+                        return begin;
+                    }
+                    cp = (cp << 6) | (c & 0x3fu);
+                }
+                if (cp < min || cp > 0x10ffff ||
+                    (cp >= 0xd800 && cp <= 0xdfff)) {
+                    return begin;
+                }
+                begin += len;
+            }
+        }
+    }  // namespace detail
+
+    SCN_END_NAMESPACE
+}  // namespace scn
@@ -73,6 +73,10 @@ namespace scn {
     SCN_VSCAN_DEFINE(std::wstring, wstring_wrapped, wstring_char)
     SCN_VSCAN_DEFINE(file&, file_ref_wrapped, file_ref_char)
     SCN_VSCAN_DEFINE(wfile&, wfile_ref_wrapped, wfile_ref_char)
+    SCN_VSCAN_DEFINE(valid_utf8_view,
+                     valid_utf8_view_wrapped,
+                     valid_utf8_view_char)
+    SCN_VSCAN_DEFINE(ascii_view, ascii_view_wrapped, ascii_view_char)
 
 #endif
 
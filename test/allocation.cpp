@@ -0,0 +1,143 @@
+// Copyright 2017 Elias Kosunen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// This file is a part of scnlib:
+//     https://github.com/eliaskosunen/scnlib
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "test.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+// Counts every allocation made through the global operator new
+static std::atomic<std::size_t> allocation_count{0};
+
+void* operator new(std::size_t size)
+{
+    ++allocation_count;
+    if (auto p = std::malloc(size == 0 ? 1 : size)) {
+        return p;
+    }
+    throw std::bad_alloc{};
+}
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+namespace {
+    struct allocation_counter {
+        std::size_t start{allocation_count.load()};
+
+        std::size_t count() const
+        {
+            return allocation_count.load() - start;
+        }
+    };
+
+    template <typename F>
+    std::size_t steady_state_allocations(F f)
+    {
+        // warm up
+        for (int i = 0; i != 4; ++i) {
+            f();
+        }
+        allocation_counter counter{};
+        for (int i = 0; i != 64; ++i) {
+            f();
+        }
+        return counter.count();
+    }
+}  // namespace
+
+TEST_CASE("scratch_string")
+{
+    SUBCASE("reuse")
+    {
+        const char* data{};
+        {
+            scn::detail::scratch_string<char> s{};
+            s.get().assign(100, 'a');
+            data = s.get().data();
+        }
+        scn::detail::scratch_string<char> s{};
+        CHECK(s.get().empty());
+        s.get().assign(100, 'b');
+        CHECK(s.get().data() == data);
+    }
+    SUBCASE("nesting")
+    {
+        scn::detail::scratch_string<char> a{};
+        scn::detail::scratch_string<char> b{};
+        CHECK(&a.get() != &b.get());
+
+        std::vector<scn::detail::scratch_string<char>> v(8);
+        for (auto& s : v) {
+            CHECK(&s.get() != &a.get());
+            CHECK(&s.get() != &b.get());
+        }
+    }
+}
+
+TEST_CASE("steady-state allocations")
+{
+    SUBCASE("deque")
+    {
+        auto source = get_deque<char>(
+            "123456789 3.14159 true 1,234 abcdefghijklmnopqrstuvwxyz");
+        auto n = steady_state_allocations([&]() {
+            int i{};
+            double d{};
+            bool b{};
+            int t{};
+            char buf[64]{};
+            auto span = scn::make_span(buf, 64);
+            auto ret = scn::scan(source, "{} {} {:s} {:'} {}", i, d, b, t,
+                                 span);
+            CHECK(ret);
+            CHECK(i == 123456789);
+            CHECK(t == 1234);
+        });
+        CHECK(n == 0);
+    }
+
+    SUBCASE("file")
+    {
+        auto f = std::tmpfile();
+        REQUIRE(f);
+        for (int i = 0; i != 256; ++i) {
+            std::fputs("123456 3.14159 ", f);
+        }
+        std::rewind(f);
+
+        scn::file file{f};
+        auto n = steady_state_allocations([&]() {
+            int i{};
+            double d{};
+            auto ret = scn::scan(file, "{} {}", i, d);
+            CHECK(ret);
+            CHECK(i == 123456);
+            file.sync();
+        });
+        CHECK(n == 0);
+        std::fclose(f);
+    }
+}
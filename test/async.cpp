@@ -0,0 +1,225 @@
+// Copyright 2017 Elias Kosunen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// This file is a part of scnlib:
+//     https://github.com/eliaskosunen/scnlib
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "test.h"
+
+#include <scn/scan/async.h>
+
+#if SCN_HAS_COROUTINES && defined(__linux__)
+
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <map>
+
+// Single-threaded executor: resumes coroutines waiting on readable fds.
+// When nothing is readable, `on_idle` is called to produce more input.
+class epoll_executor {
+public:
+    struct awaiter {
+        epoll_executor& ex;
+        int fd;
+
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
+        void await_suspend(std::coroutine_handle<> h)
+        {
+            ex.m_waiting[fd] = h;
+            epoll_event ev{};
+            ev.events = EPOLLIN | EPOLLONESHOT;
+            ev.data.fd = fd;
+            if (epoll_ctl(ex.m_epoll, EPOLL_CTL_MOD, fd, &ev) != 0) {
+                epoll_ctl(ex.m_epoll, EPOLL_CTL_ADD, fd, &ev);
+            }
+        }
+        void await_resume() const noexcept {}
+    };
+
+    epoll_executor() : m_epoll(epoll_create1(0)) {}
+    ~epoll_executor()
+    {
+        close(m_epoll);
+    }
+
+    awaiter readable(int fd)
+    {
+        return {*this, fd};
+    }
+
+    template <typename F>
+    void run(F on_idle)
+    {
+        while (!m_waiting.empty()) {
+            epoll_event evs[8];
+            int n = epoll_wait(m_epoll, evs, 8, 0);
+            if (n == 0) {
+                on_idle();
+                continue;
+            }
+            for (int i = 0; i < n; ++i) {
+                auto it = m_waiting.find(evs[i].data.fd);
+                auto h = it->second;
+                m_waiting.erase(it);
+                h.resume();
+            }
+        }
+    }
+
+private:
+    int m_epoll;
+    std::map<int, std::coroutine_handle<>> m_waiting{};
+};
+
+struct fd_pair {
+    fd_pair(bool socket)
+    {
+        int fds[2];
+        if (socket) {
+            REQUIRE(socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+        }
+        else {
+            REQUIRE(pipe(fds) == 0);
+        }
+        read_end = fds[0];
+        write_end = fds[1];
+        fcntl(read_end, F_SETFL, fcntl(read_end, F_GETFL) | O_NONBLOCK);
+    }
+    ~fd_pair()
+    {
+        close(read_end);
+        if (write_end != -1) {
+            close(write_end);
+        }
+    }
+
+    // Writes the next chunk, or closes the write end after the last one
+    void write_next(const std::vector<std::string>& chunks)
+    {
+        if (next == chunks.size()) {
+            REQUIRE(write_end != -1);
+            close(write_end);
+            write_end = -1;
+            return;
+        }
+        auto& c = chunks[next++];
+        REQUIRE(write(write_end, c.data(), c.size()) ==
+                static_cast<ssize_t>(c.size()));
+    }
+
+    int read_end, write_end;
+    size_t next{0};
+};
+
+SCN_GCC_PUSH
+SCN_GCC_IGNORE("-Wswitch-default")
+
+static scn::async_task<scn::error> sum_ints(
+    scn::async_fd_source<epoll_executor>& src,
+    std::vector<int>& out)
+{
+    // Skip the header line
+    auto e = co_await scn::async_ignore_until(src, '\n');
+    if (!e) {
+        co_return e;
+    }
+    while (true) {
+        int i{};
+        e = co_await scn::async_scan_default(src, i);
+        if (!e) {
+            co_return e;
+        }
+        out.push_back(i);
+    }
+}
+
+SCN_GCC_POP
+
+TEST_CASE("async_scan over a pipe")
+{
+    epoll_executor ex{};
+    fd_pair fds{false};
+    std::vector<std::string> chunks{"# he", "ader\n1 2", "3 4", "5\n6", "",
+                                    " 78"};
+
+    scn::async_fd_source<epoll_executor> src{ex, fds.read_end, 2};
+    std::vector<int> out;
+    auto task = sum_ints(src, out);
+    task.start();
+    ex.run([&]() { fds.write_next(chunks); });
+
+    REQUIRE(task.done());
+    CHECK(task.result() == scn::error::end_of_range);
+    CHECK(out == std::vector<int>{1, 23, 45, 6, 78});
+}
+
+SCN_GCC_PUSH
+SCN_GCC_IGNORE("-Wswitch-default")
+
+static scn::async_task<scn::error> read_records(
+    scn::async_fd_source<epoll_executor>& src,
+    std::vector<std::string>& names)
+{
+    std::string name;
+    int value{};
+    while (true) {
+        auto e = co_await scn::async_scan(src, " {:[a-z]}={}", name, value);
+        if (e.code() == scn::error::end_of_range) {
+            co_return {};
+        }
+        if (!e) {
+            // Skip the rest of a malformed record
+            std::string rest;
+            e = co_await scn::async_scan(src, " {:[^\n]}", rest);
+            if (!e) {
+                co_return e;
+            }
+            continue;
+        }
+        names.push_back(name + ":" + std::to_string(value));
+    }
+}
+
+SCN_GCC_POP
+
+TEST_CASE("async_scan over a socketpair")
+{
+    epoll_executor ex{};
+    fd_pair fds{true};
+    std::vector<std::string> chunks{"alpha=", "1\nbeta=x", "yz garbage\n",
+                                    "gam",    "ma=3",     "\n"};
+
+    scn::async_fd_source<epoll_executor> src{ex, fds.read_end};
+    std::vector<std::string> names;
+    auto task = read_records(src, names);
+    task.start();
+    ex.run([&]() { fds.write_next(chunks); });
+
+    REQUIRE(task.done());
+    CHECK(task.result());
+    CHECK(names == std::vector<std::string>{"alpha:1", "gamma:3"});
+}
+
+#else
+
+TEST_CASE("async_scan") {}
+
+#endif
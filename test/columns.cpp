@@ -0,0 +1,128 @@
+// Copyright 2017 Elias Kosunen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// This file is a part of scnlib:
+//     https://github.com/eliaskosunen/scnlib
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "test.h"
+
+TEST_CASE("columns")
+{
+    std::vector<int> ids;
+    std::vector<double> values;
+    auto ret = scn::scan_columns("1 3.14\n2 2.5\n3 -1\n", "{} {}", ids, values);
+    CHECK(ret);
+    CHECK(ret.rows() == 3);
+
+    std::vector<int> cmp_ids{1, 2, 3};
+    std::vector<double> cmp_values{3.14, 2.5, -1.0};
+    CHECK(ids == cmp_ids);
+    CHECK(values.size() == cmp_values.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+        CHECK(values[i] == doctest::Approx(cmp_values[i]));
+    }
+}
+
+TEST_CASE("comma separated columns")
+{
+    std::vector<int> a;
+    std::vector<std::string> b;
+    std::vector<unsigned> c;
+    auto ret = scn::scan_columns("1, foo, 2\n3, bar, 4", "{}, {:[^,]}, {}",
+                                 a, b, c);
+    CHECK(ret);
+    CHECK(ret.rows() == 2);
+    CHECK(a == std::vector<int>{1, 3});
+    CHECK(b == std::vector<std::string>{"foo", "bar"});
+    CHECK(c == std::vector<unsigned>{2, 4});
+}
+
+TEST_CASE("columns with explicit argument ids")
+{
+    std::vector<int> a, b;
+    auto ret = scn::scan_columns("1 2\n3 4", "{1} {0}", a, b);
+    CHECK(ret);
+    CHECK(ret.rows() == 2);
+    CHECK(a == std::vector<int>{2, 4});
+    CHECK(b == std::vector<int>{1, 3});
+}
+
+TEST_CASE("columns error position")
+{
+    std::vector<int> ids;
+    std::vector<double> values;
+    auto ret = scn::scan_columns("1 3.14\n2 2.5\n3 x\n4 1", "{} {}", ids,
+                                 values);
+    CHECK(!ret);
+    CHECK(ret.error() == scn::error::invalid_scanned_value);
+    CHECK(ret.rows() == 2);
+    CHECK(ids.size() == 2);
+    CHECK(values.size() == 2);
+    CHECK(ret.range_as_string() == "\n3 x\n4 1");
+}
+
+TEST_CASE("columns truncated row")
+{
+    std::vector<int> a, b;
+    auto ret = scn::scan_columns("1 2\n3", "{} {}", a, b);
+    CHECK(!ret);
+    CHECK(ret.error() == scn::error::end_of_range);
+    CHECK(ret.rows() == 1);
+    CHECK(a == std::vector<int>{1});
+    CHECK(b == std::vector<int>{2});
+    CHECK(ret.range_as_string() == "\n3");
+}
+
+TEST_CASE("columns every column required")
+{
+    std::vector<int> a, b;
+    auto ret = scn::scan_columns("1 2", "{0} {0}", a, b);
+    CHECK(!ret);
+    CHECK(ret.error() == scn::error::invalid_format_string);
+    CHECK(ret.rows() == 0);
+    CHECK(a.empty());
+    CHECK(b.empty());
+}
+
+TEST_CASE("columns into span")
+{
+    std::vector<int> buf_a(2, 0), buf_b(2, 0);
+    auto a = scn::make_span_list_wrapper(buf_a);
+    auto b = scn::make_span_list_wrapper(buf_b);
+    auto ret = scn::scan_columns("1 2 3 4 5 6", "{} {}", a.value, b.value);
+    CHECK(ret);
+    CHECK(ret.rows() == 2);
+    CHECK(buf_a == std::vector<int>{1, 3});
+    CHECK(buf_b == std::vector<int>{2, 4});
+    CHECK(ret.range_as_string() == " 5 6");
+}
+
+TEST_CASE("columns from file")
+{
+    std::vector<int> a, b;
+    auto handle = std::tmpfile();
+    REQUIRE(handle);
+    std::fputs("1 2\n3 4\n", handle);
+    std::rewind(handle);
+    {
+        auto f = scn::file(handle);
+        auto ret = scn::scan_columns(f, "{} {}", a, b);
+        CHECK(ret);
+        CHECK(ret.rows() == 2);
+    }
+    std::fclose(handle);
+    CHECK(a == std::vector<int>{1, 3});
+    CHECK(b == std::vector<int>{2, 4});
+}
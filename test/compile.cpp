@@ -0,0 +1,148 @@
+// Copyright 2017 Elias Kosunen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// This file is a part of scnlib:
+//     https://github.com/eliaskosunen/scnlib
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "test.h"
+
+#if SCN_HAS_RELAXED_CONSTEXPR
+
+TEST_CASE("compiled format")
+{
+    int i{};
+    double d{};
+    std::string s{};
+    auto ret = scn::scan("42 3.14 foo", SCN_COMPILE("{} {} {}"), i, d, s);
+    CHECK(ret);
+    CHECK(ret.empty());
+    CHECK(i == 42);
+    CHECK(d == doctest::Approx(3.14));
+    CHECK(s == "foo");
+}
+
+TEST_CASE("compiled format reuse")
+{
+    const auto f = SCN_COMPILE("{:x}, {}");
+    int a{}, b{};
+
+    auto ret = scn::scan("ff, 10 1a, 20", f, a, b);
+    CHECK(ret);
+    CHECK(a == 0xff);
+    CHECK(b == 10);
+
+    ret = scn::scan(ret.range(), f, a, b);
+    CHECK(ret);
+    CHECK(ret.empty());
+    CHECK(a == 0x1a);
+    CHECK(b == 20);
+}
+
+TEST_CASE("compiled format reuse with a detected base")
+{
+    // The scanner is shared: a base detected from a prefix is per-value
+    const auto f = SCN_COMPILE("{:i}");
+    int i{};
+
+    auto ret = scn::scan("0x10", f, i);
+    CHECK(ret);
+    CHECK(i == 16);
+
+    ret = scn::scan("10", f, i);
+    CHECK(ret);
+    CHECK(i == 10);
+}
+
+TEST_CASE("compiled format literals and ids")
+{
+    int a{}, b{};
+    auto ret = scn::scan("[1:2]", SCN_COMPILE("[{1}:{0}]"), a, b);
+    CHECK(ret);
+    CHECK(a == 2);
+    CHECK(b == 1);
+
+    ret = scn::scan("{3}", SCN_COMPILE("{{{}}}"), a);
+    CHECK(ret);
+    CHECK(ret.empty());
+    CHECK(a == 3);
+}
+
+TEST_CASE("compiled format mismatch")
+{
+    int a{}, b{};
+    auto ret = scn::scan("1 - 2", SCN_COMPILE("{} + {}"), a, b);
+    CHECK(!ret);
+    CHECK(ret.error() == scn::error::invalid_scanned_value);
+    CHECK(ret.range_as_string() == "1 - 2");
+
+    auto cmp = scn::scan("1 - 2", "{} + {}", a, b);
+    CHECK(ret.error() == cmp.error());
+    CHECK(ret.range_as_string() == cmp.range_as_string());
+
+    ret = scn::scan("1 x", SCN_COMPILE("{} {}"), a, b);
+    CHECK(!ret);
+    CHECK(ret.error() == scn::error::invalid_scanned_value);
+    CHECK(ret.range_as_string() == "1 x");
+}
+
+TEST_CASE("compiled format string set")
+{
+    std::string a, b;
+    auto ret = scn::scan("foo,bar", SCN_COMPILE("{:[^,]},{}"), a, b);
+    CHECK(ret);
+    CHECK(a == "foo");
+    CHECK(b == "bar");
+}
+
+TEST_CASE("compiled format wide")
+{
+    int a{};
+    std::wstring s{};
+    auto ret = scn::scan(L"123 abc", SCN_COMPILE(L"{} {}"), a, s);
+    CHECK(ret);
+    CHECK(a == 123);
+    CHECK(s == L"abc");
+}
+
+#define CHECK_COMPILED_FORMAT(str, result, ...)                         \
+    do {                                                               \
+        auto s = SCN_STRING(str);                                      \
+        static_assert(                                                 \
+            scn::detail::check_compiled_format<decltype(s), __VA_ARGS__>() == \
+                scn::detail::format_compile_error::result,             \
+            str);                                                      \
+    } while (false)
+
+TEST_CASE("compiled format errors")
+{
+    CHECK_COMPILED_FORMAT("{} {}", none, int, int);
+    CHECK_COMPILED_FORMAT("{} {}", arg_id_out_of_range, int);
+    CHECK_COMPILED_FORMAT("{", unexpected_end, int);
+    CHECK_COMPILED_FORMAT("{0} {1}", none, int, int);
+    CHECK_COMPILED_FORMAT("{} {1}", mixed_arg_id, int, int);
+    CHECK_COMPILED_FORMAT("{a}", invalid_arg_id, int);
+    CHECK_COMPILED_FORMAT("{:xx}", invalid_specifier, int);
+    CHECK_COMPILED_FORMAT("{:dx}", invalid_specifier, int);
+    CHECK_COMPILED_FORMAT("{:B16}", none, int);
+    CHECK_COMPILED_FORMAT("{:B1}", invalid_specifier, int);
+    CHECK_COMPILED_FORMAT("{:x}", invalid_specifier, double);
+    CHECK_COMPILED_FORMAT("{:>4L}", invalid_specifier, double);
+    CHECK_COMPILED_FORMAT("{:*<a}", none, double);
+    CHECK_COMPILED_FORMAT("{:[a-z]}", none, std::string);
+    CHECK_COMPILED_FORMAT("{:[a-z}", invalid_specifier, std::string);
+    CHECK_COMPILED_FORMAT("{:[a-z]}", invalid_specifier, int);
+}
+
+#endif
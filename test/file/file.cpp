@@ -151,6 +151,33 @@ TEST_CASE_TEMPLATE("file", CharT, char, wchar_t)
     }
 }
 
+TEST_CASE("file getline")
+{
+    auto f = std::tmpfile();
+    REQUIRE(f);
+    std::fputs("123\n456\n", f);
+    std::rewind(f);
+
+    {
+        scn::file file{f};
+
+        std::string line;
+        auto result = scn::getline(file, line);
+        CHECK(result);
+        CHECK(line == "123");
+
+        result = scn::getline(result.range(), line);
+        CHECK(result);
+        CHECK(line == "456");
+
+        result = scn::getline(result.range(), line);
+        CHECK(!result);
+        CHECK(result.error().code() == scn::error::end_of_range);
+    }
+
+    std::fclose(f);
+}
+
 TEST_CASE("mapped file")
 {
     scn::mapped_file file{"./test/file/testfile.txt"};
@@ -0,0 +1,113 @@
+// Copyright 2017 Elias Kosunen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// This file is a part of scnlib:
+//     https://github.com/eliaskosunen/scnlib
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <scn/scan/tail.h>
+#include <cstdio>
+#include "../test.h"
+
+static const char* tail_filename = "./test/file/tail.log";
+
+static void write_file(const char* mode, const std::string& content)
+{
+    auto f = std::fopen(tail_filename, mode);
+    REQUIRE(f);
+    std::fwrite(content.data(), 1, content.size(), f);
+    std::fclose(f);
+}
+
+TEST_CASE("tail_file")
+{
+    write_file("w", "1 2 3");
+
+    scn::tail_file file{tail_filename};
+    REQUIRE(file.valid());
+
+    std::vector<int> values;
+    auto drain = [&]() {
+        int i{};
+        while (file.scanner().scan_default(i)) {
+            values.push_back(i);
+        }
+    };
+
+    auto n = file.poll();
+    CHECK(n);
+    CHECK(n.value() == 5);
+    drain();
+    // "3" may continue
+    CHECK(values == std::vector<int>{1, 2});
+    CHECK(file.checkpoint() == 3);
+
+    n = file.poll();
+    CHECK(n);
+    CHECK(n.value() == 0);
+
+    write_file("a", "4 5\n");
+    n = file.poll();
+    CHECK(n);
+    CHECK(n.value() == 4);
+    drain();
+    CHECK(values == std::vector<int>{1, 2, 34, 5});
+    CHECK(file.checkpoint() == 8);
+
+    SUBCASE("resume from checkpoint")
+    {
+        write_file("a", "6 7 8");
+        scn::tail_file resumed{tail_filename, file.checkpoint()};
+        CHECK(resumed.poll());
+        int i{}, j{};
+        CHECK(resumed.scanner().scan("{} {}", i, j));
+        CHECK(i == 6);
+        CHECK(j == 7);
+        CHECK(resumed.checkpoint() == 12);
+    }
+    SUBCASE("truncated")
+    {
+        write_file("w", "9 ");
+        CHECK(file.poll());
+        drain();
+        CHECK(values == std::vector<int>{1, 2, 34, 5, 9});
+        CHECK(file.checkpoint() == 1);
+    }
+    SUBCASE("small chunks")
+    {
+        write_file("a", "10 11 12\n");
+        scn::tail_file small{tail_filename, file.checkpoint(), 2};
+        std::vector<int> read;
+        while (true) {
+            auto r = small.poll();
+            REQUIRE(r);
+            if (r.value() == 0) {
+                break;
+            }
+            int i{};
+            while (small.scanner().scan_default(i)) {
+                read.push_back(i);
+            }
+        }
+        CHECK(read == std::vector<int>{10, 11, 12});
+    }
+
+    std::remove(tail_filename);
+}
+
+TEST_CASE("tail_file invalid")
+{
+    scn::tail_file file{"./test/file/does-not-exist"};
+    CHECK(!file.valid());
+}
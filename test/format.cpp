@@ -162,3 +162,54 @@ TEST_CASE("utf8 literal")
         CHECK(b2 == static_cast<char>(0xb6));
     }
 }
+
+TEST_CASE("literal runs")
+{
+    int a{}, b{};
+    SUBCASE("match")
+    {
+        auto e = scn::scan("timestamp=12 level=3", "timestamp={} level={}",
+                           a, b);
+        CHECK(e);
+        CHECK(e.empty());
+        CHECK(a == 12);
+        CHECK(b == 3);
+    }
+    SUBCASE("mismatch")
+    {
+        auto e = scn::scan("key=1 kez=2", "key={} key={}", a, b);
+        CHECK(!e);
+        CHECK(e.error() == scn::error::invalid_scanned_value);
+        CHECK(e.range_as_string() == "key=1 kez=2");
+    }
+    SUBCASE("end of range")
+    {
+        auto e = scn::scan("ke", "key={}", a);
+        CHECK(!e);
+        CHECK(e.error() == scn::error::end_of_range);
+        CHECK(e.range_as_string() == "ke");
+    }
+    SUBCASE("wide")
+    {
+        auto e = scn::scan(L"[1,2]", L"[{},{}]", a, b);
+        CHECK(e);
+        CHECK(e.empty());
+        CHECK(a == 1);
+        CHECK(b == 2);
+    }
+    SUBCASE("file")
+    {
+        auto handle = std::tmpfile();
+        REQUIRE(handle);
+        std::fputs("key=1 key=2", handle);
+        std::rewind(handle);
+        {
+            auto f = scn::file(handle);
+            auto e = scn::scan(f, "key={} key={}", a, b);
+            CHECK(e);
+        }
+        std::fclose(handle);
+        CHECK(a == 1);
+        CHECK(b == 2);
+    }
+}
@@ -177,6 +177,12 @@ TEST_CASE("format string")
     CHECK(ret);
     CHECK(i == 0);
 
+    // Prefix without digits -> just 0
+    ret = scn::scan("0x y", "{:i}", i);
+    CHECK(ret);
+    CHECK(i == 0);
+    CHECK(ret.range_as_string() == "x y");
+
     // Again, decimal by default
     ret = scn::scan("15", "{:i}", i);
     CHECK(ret);
@@ -449,6 +455,23 @@ TEST_CASE_TEMPLATE_DEFINE("integer", T, integer_test)
         CHECK(e.error() == scn::error::invalid_scanned_value);
         CHECK(i == 0);
     }
+    {
+        value_type i{};
+        auto e = do_scan<char_type>("- 1", "{}", i);
+        CHECK(!e);
+        CHECK(e.error() == scn::error::invalid_scanned_value);
+        if (std::is_signed<value_type>::value) {
+            CHECK(std::string{e.error().msg()} ==
+                  "Expected number after sign");
+        }
+        CHECK(i == 0);
+
+        // No sign: not reported as a missing number after one
+        e = do_scan<char_type>("abc", "{}", i);
+        CHECK(!e);
+        CHECK(e.error() == scn::error::invalid_scanned_value);
+        CHECK(std::string{e.error().msg()} != "Expected number after sign");
+    }
 
     {
         value_type i{};
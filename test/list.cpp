@@ -80,3 +80,67 @@ TEST_CASE("comma list until line break")
     CHECK(values.size() == cmp.size());
     CHECK(std::equal(values.begin(), values.end(), cmp.begin()));
 }
+
+TEST_CASE("list separators and whitespace")
+{
+    std::vector<int> values;
+    auto ret = scn::scan_list_ex("0 ,1,, 2 \t\n 3,\n\n4 x", values,
+                                 scn::list_separator(','));
+    CHECK(!ret);
+    CHECK(ret.error() == scn::error::invalid_scanned_value);
+    CHECK(ret.range_as_string() == " x");
+    CHECK(values == std::vector<int>{0, 1, 2, 3, 4});
+
+    values.clear();
+    ret = scn::scan_list_ex("0, 1 ,  2 \t  \n3", values,
+                            scn::list_separator_and_until(',', '\n'));
+    CHECK(ret);
+    CHECK(ret.range_as_string() == "\n3");
+    CHECK(values == std::vector<int>{0, 1, 2});
+
+    values.clear();
+    ret = scn::scan_list_ex("0, 1,", values, scn::list_separator(','));
+    CHECK(ret);
+    CHECK(ret.empty());
+    CHECK(values == std::vector<int>{0, 1});
+}
+
+TEST_CASE("non-contiguous list")
+{
+    auto source = get_deque<char>("0, 1 ,  2\n3");
+    std::vector<int> values;
+    auto ret = scn::scan_list_ex(source, values,
+                                 scn::list_separator_and_until(',', '\n'));
+    CHECK(ret);
+    CHECK(values == std::vector<int>{0, 1, 2});
+    CHECK(ret.range().size() == 2);
+}
+
+TEST_CASE("wide list")
+{
+    std::vector<int> values;
+    auto ret = scn::scan_list_ex(L"0, 1 ,  2\n3", values,
+                                 scn::list_separator_and_until(L',', L'\n'));
+    CHECK(ret);
+    CHECK(values == std::vector<int>{0, 1, 2});
+    CHECK(ret.range_as_string() == L"\n3");
+}
+
+TEST_CASE("code point separator list")
+{
+    std::vector<int> values;
+    auto ret = scn::scan_list_ex(
+        "0; 1 ;2|3", values,
+        scn::list_separator_and_until(scn::make_code_point(';'),
+                                      scn::make_code_point('|')));
+    CHECK(ret);
+    CHECK(values == std::vector<int>{0, 1, 2});
+    CHECK(ret.range_as_string() == "|3");
+
+    // Non-ASCII separator (U+00B7 MIDDLE DOT)
+    values.clear();
+    ret = scn::scan_list_ex("0\xc2\xb7 1 \xc2\xb7" "2", values,
+                            scn::list_separator(scn::make_code_point(0xb7)));
+    CHECK(ret);
+    CHECK(values == std::vector<int>{0, 1, 2});
+}
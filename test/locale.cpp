@@ -177,6 +177,41 @@ TEST_CASE("custom locale")
                  0);
     }
 
+    SUBCASE("classify")
+    {
+        using scn::detail::ctype_class;
+        const auto& classic = std::locale::classic();
+
+        auto cls = loc.classify('a');
+        CHECK((cls & ctype_class::alpha) != 0);
+        CHECK((cls & ctype_class::lower) != 0);
+        CHECK((cls & ctype_class::xdigit) != 0);
+        CHECK((cls & ctype_class::space) == 0);
+
+        cls = wloc.classify(L'\t');
+        CHECK((cls & ctype_class::space) != 0);
+        CHECK((cls & ctype_class::blank) != 0);
+        CHECK((cls & ctype_class::cntrl) != 0);
+        CHECK((cls & ctype_class::print) == 0);
+
+        cls = loc.classify(scn::make_span("7", 1).as_const());
+        CHECK(cls == loc.classify(scn::make_code_point('7')));
+        CHECK((cls & ctype_class::digit) != 0);
+
+        for (uint32_t i = 0; i < 0x11000; i += 31) {
+            const auto cp = scn::make_code_point(i);
+            const auto ch = static_cast<wchar_t>(i);
+            cls = loc.classify(cp);
+            CHECK(((cls & ctype_class::alpha) != 0) ==
+                  std::isalpha(ch, classic));
+            CHECK(((cls & ctype_class::space) != 0) ==
+                  std::isspace(ch, classic));
+            CHECK(((cls & ctype_class::punct) != 0) ==
+                  std::ispunct(ch, classic));
+            CHECK(cls == wloc.classify(cp));
+        }
+    }
+
 #if 0
     SUBCASE("widen & narrow")
     {
@@ -226,3 +261,167 @@ TEST_CASE("default localized scanning")
         CHECK(d == doctest::Approx(100.2));
     }
 }
+
+namespace {
+    template <typename CharT>
+    struct grouped_numpunct : std::numpunct<CharT> {
+        CharT do_decimal_point() const override
+        {
+            return scn::detail::ascii_widen<CharT>(',');
+        }
+        CharT do_thousands_sep() const override
+        {
+            return scn::detail::ascii_widen<CharT>('.');
+        }
+        std::string do_grouping() const override
+        {
+            return "\3";
+        }
+    };
+}  // namespace
+
+TEST_CASE("localized number grouping")
+{
+    std::locale custom{std::locale::classic(), new grouped_numpunct<char>{}};
+    std::locale wcustom{std::locale::classic(),
+                        new grouped_numpunct<wchar_t>{}};
+
+    SUBCASE("read_num")
+    {
+        SCN_CLANG_PUSH_IGNORE_UNDEFINED_TEMPLATE
+        scn::detail::basic_custom_locale_ref<char> loc{&custom};
+        scn::detail::basic_custom_locale_ref<wchar_t> wloc{&wcustom};
+        SCN_CLANG_POP_IGNORE_UNDEFINED_TEMPLATE
+
+        int i{};
+        auto ret = loc.read_num(i, std::string{"1.234.567"}, 10);
+        CHECK(ret);
+        CHECK(ret.value() == 9);
+        CHECK(i == 1234567);
+
+        ret = wloc.read_num(i, std::wstring{L"-12.345"}, 10);
+        CHECK(ret);
+        CHECK(ret.value() == 7);
+        CHECK(i == -12345);
+
+        ret = loc.read_num(i, std::string{"123."}, 10);
+        CHECK(ret);
+        CHECK(ret.value() == 3);
+        CHECK(i == 123);
+
+        ret = loc.read_num(i, std::string{"12.34"}, 10);
+        CHECK(!ret);
+        CHECK(ret.error() == scn::error::invalid_scanned_value);
+
+        ret = loc.read_num(i, std::string{"99.999.999.999"}, 10);
+        CHECK(!ret);
+        CHECK(ret.error() == scn::error::value_out_of_range);
+
+        double d{};
+        ret = loc.read_num(d, std::string{"1.234,5"}, 0);
+        CHECK(ret);
+        CHECK(ret.value() == 7);
+        CHECK(d == doctest::Approx(1234.5));
+
+        ret = loc.read_num(d, std::string{"3,14e2x"}, 0);
+        CHECK(ret);
+        CHECK(ret.value() == 6);
+        CHECK(d == doctest::Approx(314.0));
+
+        ret = wloc.read_num(d, std::wstring{L"2,5,6"}, 0);
+        CHECK(ret);
+        CHECK(ret.value() == 3);
+        CHECK(d == doctest::Approx(2.5));
+    }
+
+#if !SCN_USE_STATIC_LOCALE
+    SUBCASE("scan")
+    {
+        int i{};
+        double d{};
+        auto ret = scn::scan_localized(custom, "1.000 2.500,25", "{:n} {:n}",
+                                       i, d);
+        CHECK(ret);
+        CHECK(i == 1000);
+        CHECK(d == doctest::Approx(2500.25));
+    }
+#endif
+}
+
+TEST_CASE("shared locale")
+{
+    SCN_CLANG_PUSH_IGNORE_UNDEFINED_TEMPLATE
+    auto a = scn::shared_locale{std::locale::classic()};
+    auto b = scn::shared_locale{std::locale::classic()};
+    auto w = scn::wshared_locale{std::locale::classic()};
+    SCN_CLANG_POP_IGNORE_UNDEFINED_TEMPLATE
+
+    CHECK(a);
+    CHECK(&a.get() == &b.get());
+    CHECK(a.get().decimal_point() == '.');
+    CHECK(w.get().decimal_point() == L'.');
+
+    SUBCASE("copy and move")
+    {
+        auto c = a;
+        CHECK(&c.get() == &a.get());
+        auto d = std::move(c);
+        CHECK(!c);
+        CHECK(&d.get() == &a.get());
+        c = d;
+        CHECK(&c.get() == &a.get());
+    }
+
+    SUBCASE("distinct locales")
+    {
+        std::locale custom{std::locale::classic(),
+                           new grouped_numpunct<char>{}};
+        auto c = scn::shared_locale{custom};
+        CHECK(&c.get() != &a.get());
+        CHECK(c.get().decimal_point() == ',');
+
+        auto copy = custom;
+        auto d = scn::shared_locale{copy};
+        CHECK(&c.get() == &d.get());
+
+        int i{};
+        auto ret = c.get().read_num(i, std::string{"1.234"}, 10);
+        CHECK(ret);
+        CHECK(i == 1234);
+    }
+
+    SUBCASE("outlives the cache entry")
+    {
+        auto c = scn::shared_locale{
+            std::locale{std::locale::classic(), new grouped_numpunct<char>{}}};
+        for (int n = 0; n != 16; ++n) {
+            auto tmp = scn::shared_locale{std::locale{
+                std::locale::classic(), new grouped_numpunct<char>{}}};
+            CHECK(&tmp.get() != &c.get());
+        }
+        CHECK(c.get().thousands_separator() == '.');
+    }
+
+#if !SCN_USE_STATIC_LOCALE
+    SUBCASE("scan")
+    {
+        int i{};
+        double d{};
+        auto ret = scn::scan_localized(a, "42 3.14", "{:L} {:L}", i, d);
+        CHECK(ret);
+        CHECK(i == 42);
+        CHECK(d == doctest::Approx(3.14));
+    }
+    SUBCASE("locale_ref")
+    {
+        // Every locale_ref made from `a` reads the same, immutable locale
+        auto ref = scn::make_locale_ref(a);
+        using custom_type = decltype(ref)::custom_type;
+        static_assert(std::is_same<decltype(ref.get_localized()),
+                                   const custom_type&>::value,
+                      "");
+        CHECK(&ref.get_localized() == &a.get());
+        CHECK(&ref.get(true) == &a.get());
+    }
+#endif
+}
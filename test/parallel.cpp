@@ -0,0 +1,122 @@
+// Copyright 2017 Elias Kosunen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// This file is a part of scnlib:
+//     https://github.com/eliaskosunen/scnlib
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "test.h"
+
+#include <scn/scan/parallel.h>
+
+// Enough numbers to split a list into 4 chunks in scan_list_parallel():
+// almost all of them take at least 5 code units with their separator
+static constexpr int list_size =
+    static_cast<int>(4 * scn::detail::parallel_list_min_chunk_size / 5) + 1;
+
+// `n` numbers, joined with `sep`
+static std::string make_list(const std::string& sep, int n = list_size)
+{
+    std::string s;
+    for (int i = 0; i < n; ++i) {
+        if (i != 0) {
+            s += sep;
+        }
+        s += std::to_string(i * 7 - 1000);
+    }
+    return s;
+}
+
+// scan_list_parallel() must give the same result as scan_list_ex()
+template <typename T, typename CharT>
+static void check_same(const std::string& input,
+                       scn::scan_list_options<CharT> options,
+                       std::size_t n_threads = 4)
+{
+    std::vector<T> serial, parallel;
+    auto s = scn::scan_list_ex(input, serial, options);
+    auto p = scn::scan_list_parallel(input, parallel, options, n_threads);
+
+    CHECK(s.error() == p.error());
+    CHECK(s.range_as_string_view().size() ==
+          p.range_as_string_view().size());
+    CHECK(serial.size() == parallel.size());
+    CHECK(serial == parallel);
+}
+
+TEST_CASE("scan_list_parallel")
+{
+    SUBCASE("whitespace")
+    {
+        check_same<int>(make_list(" "), scn::scan_list_options<char>{});
+        check_same<int>(make_list(" \n\t "), scn::scan_list_options<char>{});
+    }
+    SUBCASE("separator")
+    {
+        check_same<int>(make_list(","), scn::list_separator(','));
+        check_same<int>(make_list(", "), scn::list_separator(','));
+        check_same<double>(make_list(" ; "), scn::list_separator(';'));
+    }
+    SUBCASE("strings")
+    {
+        // ',' is read as a part of the strings
+        check_same<std::string>(make_list(", "), scn::list_separator(','));
+        check_same<std::string>(make_list(","), scn::list_separator(','));
+    }
+    SUBCASE("invalid value")
+    {
+        auto input = make_list(", ");
+        input.insert(input.size() * 3 / 4, "abc, ");
+        check_same<int>(input, scn::list_separator(','));
+
+        std::vector<int> vec;
+        auto ret = scn::scan_list_parallel(input, vec,
+                                           scn::list_separator(','), 4);
+        CHECK(ret.error() == scn::error::invalid_scanned_value);
+        CHECK(ret.range_as_string().substr(0, 3) == "abc");
+    }
+    SUBCASE("until")
+    {
+        auto input = make_list(" ");
+        input.insert(input.size() / 2, "\n");
+        check_same<int>(input, scn::list_until('\n'));
+        check_same<int>(input, scn::list_separator_and_until(',', '\n'));
+    }
+    SUBCASE("thread counts")
+    {
+        check_same<int>(make_list(" "), scn::scan_list_options<char>{}, 0);
+        check_same<int>(make_list(" "), scn::scan_list_options<char>{}, 1);
+        check_same<int>(make_list(" "), scn::scan_list_options<char>{}, 64);
+        check_same<int>(make_list(" ", 10), scn::scan_list_options<char>{});
+    }
+}
+
+TEST_CASE("scan_list_parallel max_size")
+{
+    auto input = make_list(", ");
+    // Room for only a part of the list
+    const auto n = static_cast<std::size_t>(list_size) * 3 / 5;
+    std::vector<int> buf(n), cmp(n);
+    scn::span_list_wrapper<int> buf_wrapper(scn::make_span(buf));
+    scn::span_list_wrapper<int> cmp_wrapper(scn::make_span(cmp));
+
+    auto p = scn::scan_list_parallel(input, buf_wrapper,
+                                     scn::list_separator(','), 4);
+    auto s = scn::scan_list_ex(input, cmp_wrapper, scn::list_separator(','));
+    CHECK(p);
+    CHECK(p.range_as_string_view().size() ==
+          s.range_as_string_view().size());
+    CHECK(buf_wrapper.size() == cmp_wrapper.size());
+    CHECK(buf == cmp);
+}
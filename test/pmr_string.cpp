@@ -32,5 +32,62 @@ TEST_CASE("pmr string")
     CHECK(ret);
     CHECK(str == "str");
 }
+
+namespace {
+    // Makes any allocation from the default memory resource fail
+    struct null_default_resource {
+        null_default_resource()
+            : prev(std::pmr::set_default_resource(
+                  std::pmr::null_memory_resource()))
+        {
+        }
+        ~null_default_resource()
+        {
+            std::pmr::set_default_resource(prev);
+        }
+
+        std::pmr::memory_resource* prev;
+    };
+}  // namespace
+
+TEST_CASE("pmr allocation")
+{
+    char buf[1024];
+    std::pmr::monotonic_buffer_resource arena{
+        buf, sizeof(buf), std::pmr::null_memory_resource()};
+    null_default_resource guard{};
+
+    SUBCASE("string from non-contiguous range")
+    {
+        std::pmr::string str{&arena};
+        auto ret = scn::scan(get_deque<char>("a-long-enough-string foo"), "{}",
+                             str);
+        CHECK(ret);
+        CHECK(str == "a-long-enough-string");
+        CHECK(str.get_allocator().resource() == &arena);
+    }
+
+    SUBCASE("getline")
+    {
+        std::pmr::string str{&arena};
+        auto ret = scn::getline(
+            get_deque<char>("a line long enough to allocate\nnext"), str);
+        CHECK(ret);
+        CHECK(str == "a line long enough to allocate");
+        CHECK(str.get_allocator().resource() == &arena);
+    }
+
+    SUBCASE("scan_list")
+    {
+        std::pmr::vector<std::pmr::string> vec{&arena};
+        auto ret = scn::scan_list(
+            "first-long-enough-string second-long-enough-string", vec);
+        CHECK(ret);
+        REQUIRE(vec.size() == 2);
+        CHECK(vec[0] == "first-long-enough-string");
+        CHECK(vec[1] == "second-long-enough-string");
+        CHECK(vec[1].get_allocator().resource() == &arena);
+    }
+}
 #endif
 #endif
@@ -0,0 +1,186 @@
+// Copyright 2017 Elias Kosunen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// This file is a part of scnlib:
+//     https://github.com/eliaskosunen/scnlib
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "test.h"
+
+TEST_CASE("prepared format")
+{
+    auto pf = scn::prepare<int, double, std::string>("{} {} {}");
+    CHECK(pf);
+
+    int i{};
+    double d{};
+    std::string s{};
+    auto ret = pf.scan("42 3.14 foo", i, d, s);
+    CHECK(ret);
+    CHECK(ret.empty());
+    CHECK(i == 42);
+    CHECK(d == doctest::Approx(3.14));
+    CHECK(s == "foo");
+}
+
+TEST_CASE("prepared format reuse")
+{
+    std::string f = "{:x}, {}";
+    auto pf = scn::prepare<int, int>(f);
+    f.clear();
+    CHECK(pf);
+    CHECK(std::string{pf.get().data(), pf.get().size()} == "{:x}, {}");
+
+    int a{}, b{};
+    auto ret = pf.scan("ff, 10 1a, 20", a, b);
+    CHECK(ret);
+    CHECK(a == 0xff);
+    CHECK(b == 10);
+
+    ret = pf.scan(ret.range(), a, b);
+    CHECK(ret);
+    CHECK(ret.empty());
+    CHECK(a == 0x1a);
+    CHECK(b == 20);
+}
+
+TEST_CASE("prepared format repeated scans")
+{
+    auto pf = scn::prepare<int, std::string>("{:i} {:[a-z]}");
+    CHECK(pf);
+
+    int i{};
+    std::string s{};
+    for (int n = 0; n < 3; ++n) {
+        // A base detected from a prefix doesn't carry over to the next scan
+        auto ret = pf.scan("0x10 abc1", i, s);
+        CHECK(ret);
+        CHECK(i == 16);
+        CHECK(s == "abc");
+        CHECK(ret.range_as_string() == "1");
+
+        ret = pf.scan("10 def", i, s);
+        CHECK(ret);
+        CHECK(i == 10);
+        CHECK(s == "def");
+    }
+}
+
+struct scan_counter {
+    int calls{0};
+};
+
+namespace scn {
+    template <>
+    struct scanner<scan_counter> : public scn::empty_parser {
+        // Non-const: the prepared scanner is copied for every value
+        template <typename Context>
+        error scan(scan_counter& val, Context&)
+        {
+            val.calls = ++calls;
+            return {};
+        }
+
+        int calls{0};
+    };
+}  // namespace scn
+
+TEST_CASE("prepared format stateful user type")
+{
+    auto pf = scn::prepare<scan_counter>("{}");
+    CHECK(pf);
+
+    scan_counter c{};
+    CHECK(pf.scan("x", c));
+    CHECK(c.calls == 1);
+    CHECK(pf.scan("x", c));
+    CHECK(c.calls == 1);
+}
+
+TEST_CASE("prepared format literals and ids")
+{
+    auto pf = scn::prepare<int, int>("[{1}:{0}] {{{0}}}");
+    CHECK(pf);
+
+    int a{}, b{};
+    auto ret = pf.scan("[1:2] {3}", a, b);
+    CHECK(ret);
+    CHECK(ret.empty());
+    CHECK(a == 3);
+    CHECK(b == 1);
+}
+
+TEST_CASE("prepared format mismatch")
+{
+    auto pf = scn::prepare<int, int>("{} + {}");
+    int a{}, b{};
+    auto ret = pf.scan("1 - 2", a, b);
+    CHECK(!ret);
+    CHECK(ret.error() == scn::error::invalid_scanned_value);
+    CHECK(ret.range_as_string() == "1 - 2");
+
+    ret = pf.scan("1 + x", a, b);
+    CHECK(!ret);
+    CHECK(ret.error() == scn::error::invalid_scanned_value);
+    CHECK(ret.range_as_string() == "1 + x");
+}
+
+TEST_CASE("prepared format string set")
+{
+    auto pf = scn::prepare<std::string, std::string>("{:[^,]},{}");
+    CHECK(pf);
+
+    std::string a, b;
+    auto ret = pf.scan("foo,bar", a, b);
+    CHECK(ret);
+    CHECK(a == "foo");
+    CHECK(b == "bar");
+}
+
+TEST_CASE("prepared format wide")
+{
+    auto pf = scn::prepare<int, std::wstring>(L"{} {}");
+    CHECK(pf);
+
+    int a{};
+    std::wstring s{};
+    auto ret = pf.scan(L"123 abc", a, s);
+    CHECK(ret);
+    CHECK(a == 123);
+    CHECK(s == L"abc");
+}
+
+TEST_CASE("prepared format errors")
+{
+    CHECK(scn::prepare<int>("{").error() ==
+          scn::error::invalid_format_string);
+    CHECK(scn::prepare<int>("{} {}").error() ==
+          scn::error::invalid_format_string);
+    CHECK(scn::prepare<int, int>("{} {1}").error() ==
+          scn::error::invalid_format_string);
+    CHECK(scn::prepare<int>("{:xx}").error() ==
+          scn::error::invalid_format_string);
+    CHECK(scn::prepare<double>("{:x}").error() ==
+          scn::error::invalid_format_string);
+    CHECK(scn::prepare<std::string>("{:[a-z}").error() ==
+          scn::error::invalid_format_string);
+
+    auto pf = scn::prepare<int>("{:q}");
+    CHECK(!pf);
+    int i{};
+    auto ret = pf.scan("123", i);
+    CHECK(!ret);
+    CHECK(ret.error() == scn::error::invalid_format_string);
+    CHECK(ret.range_as_string() == "123");
+}
@@ -0,0 +1,181 @@
+// Copyright 2017 Elias Kosunen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// This file is a part of scnlib:
+//     https://github.com/eliaskosunen/scnlib
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "test.h"
+
+TEST_CASE("push_scanner")
+{
+    scn::push_scanner scanner{};
+    int i{};
+
+    CHECK(scanner.scan_default(i).code() == scn::error::need_more_input);
+
+    scanner.feed("12 3");
+    CHECK(scanner.scan_default(i));
+    CHECK(i == 12);
+
+    // "3" may continue in the next chunk
+    CHECK(scanner.scan_default(i).code() == scn::error::need_more_input);
+    CHECK(std::string{scanner.pending().data(), scanner.pending().size()} ==
+          " 3");
+
+    scanner.feed("4 5\n");
+    CHECK(scanner.scan_default(i));
+    CHECK(i == 34);
+    CHECK(scanner.scan(" {}", i));
+    CHECK(i == 5);
+
+    CHECK(scanner.scan_default(i).code() == scn::error::need_more_input);
+    scanner.finish();
+    CHECK(scanner.finished());
+    CHECK(scanner.scan_default(i).code() == scn::error::end_of_range);
+}
+
+TEST_CASE("push_scanner finish")
+{
+    scn::push_scanner scanner{};
+    std::string word;
+
+    scanner.feed("hel");
+    CHECK(scanner.scan_default(word).code() == scn::error::need_more_input);
+    scanner.feed("lo wor");
+    CHECK(scanner.scan_default(word));
+    CHECK(word == "hello");
+    CHECK(scanner.scan_default(word).code() == scn::error::need_more_input);
+
+    scanner.finish();
+    CHECK(scanner.scan_default(word));
+    CHECK(word == "wor");
+    CHECK(scanner.scan_default(word).code() == scn::error::end_of_range);
+}
+
+TEST_CASE("push_scanner buffering")
+{
+    scn::push_scanner scanner{};
+    int i{}, j{};
+
+    // Consumed entirely: the chunk isn't copied
+    std::string first{"1 2\n"};
+    scanner.feed({first.data(), first.size()});
+    CHECK(scanner.scan("{} {}", i, j));
+    CHECK(scanner.pending().data() == first.data() + 3);
+
+    // Not consumed: the tail is copied, and the next chunk appended to it
+    std::string second{"3 4"};
+    scanner.feed({second.data(), second.size()});
+    CHECK(scanner.scan("{} {}", i, j).code() ==
+          scn::error::need_more_input);
+    std::string third{"5\n"};
+    scanner.feed({third.data(), third.size()});
+    CHECK(scanner.scan("{} {}", i, j));
+    CHECK(i == 3);
+    CHECK(j == 45);
+    CHECK(scanner.pending().data() != third.data());
+}
+
+TEST_CASE("push_scanner move")
+{
+    scn::push_scanner scanner{};
+    int i{};
+
+    // The unconsumed tail is in the internal buffer
+    scanner.feed("1 2");
+    CHECK(scanner.scan_default(i));
+    CHECK(scanner.scan_default(i).code() == scn::error::need_more_input);
+    scanner.feed("3 ");
+
+    auto moved = std::move(scanner);
+    CHECK(moved.scan_default(i));
+    CHECK(i == 23);
+
+    auto copy = moved;
+    copy.feed("4\n");
+    CHECK(copy.scan_default(i));
+    CHECK(i == 4);
+    CHECK(std::string{moved.pending().data(), moved.pending().size()} ==
+          " ");
+}
+
+TEST_CASE("push_scanner trailing literal")
+{
+    scn::push_scanner scanner{};
+    int i{};
+
+    // The ';' ends the record: no more input is needed
+    scanner.feed("1;2");
+    CHECK(scanner.scan("{};", i));
+    CHECK(i == 1);
+    CHECK(scanner.scan("{};", i).code() == scn::error::need_more_input);
+    scanner.feed("3;");
+    CHECK(scanner.scan("{};", i));
+    CHECK(i == 23);
+    CHECK(scanner.pending().empty());
+
+    // Without a trailing literal, the value may still continue
+    scanner.feed("4");
+    CHECK(scanner.scan("{}", i).code() == scn::error::need_more_input);
+}
+
+TEST_CASE("push_scanner errors")
+{
+    scn::push_scanner scanner{};
+    int i{};
+
+    // The invalid value may still continue
+    scanner.feed("ab");
+    CHECK(scanner.scan_default(i).code() == scn::error::need_more_input);
+
+    scanner.feed("c 1");
+    CHECK(scanner.scan_default(i).code() ==
+          scn::error::invalid_scanned_value);
+
+    CHECK(scanner.ignore_until(' '));
+    CHECK(scanner.scan_default(i).code() == scn::error::need_more_input);
+    scanner.feed("2\n");
+    CHECK(scanner.scan_default(i));
+    CHECK(i == 12);
+}
+
+TEST_CASE("push_scanner ignore_until")
+{
+    scn::push_scanner scanner{};
+    int i{};
+
+    scanner.feed("garbage");
+    CHECK(scanner.ignore_until('\n').code() == scn::error::need_more_input);
+    CHECK(scanner.pending().empty());
+
+    scanner.feed("more garbage\n7\n");
+    CHECK(scanner.ignore_until('\n'));
+    CHECK(scanner.scan_default(i));
+    CHECK(i == 7);
+}
+
+TEST_CASE("wpush_scanner")
+{
+    scn::wpush_scanner scanner{};
+    std::wstring word;
+
+    scanner.feed(L"wide wo");
+    CHECK(scanner.scan_default(word));
+    CHECK(word == L"wide");
+    CHECK(scanner.scan_default(word).code() == scn::error::need_more_input);
+    scanner.feed(L"rd ");
+    CHECK(scanner.scan_default(word));
+    CHECK(word == L"word");
+}
@@ -18,6 +18,8 @@
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 #include "test.h"
 
+#include <list>
+
 template <typename T>
 struct debug;
 
@@ -229,3 +231,14 @@ TEST_CASE("non default constructible range: rvalue")
     CHECK(ret.range().empty());
 }
 #endif
+
+#if !SCN_USE_STD_RANGES
+TEST_CASE("polyfill random_access_iterator")
+{
+    CHECK(scn::polyfill_2a::random_access_iterator<const char*>::value);
+    CHECK(scn::polyfill_2a::random_access_iterator<
+          std::string::const_iterator>::value);
+    CHECK(!scn::polyfill_2a::random_access_iterator<
+          std::list<char>::iterator>::value);
+}
+#endif
@@ -0,0 +1,146 @@
+// Copyright 2017 Elias Kosunen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// This file is a part of scnlib:
+//     https://github.com/eliaskosunen/scnlib
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "test.h"
+
+#include <scn/detail/simd.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace {
+    const char* reference_space(const char* b, const char* e)
+    {
+        for (; b != e && !scn::detail::is_space(*b); ++b) {
+        }
+        return b;
+    }
+    const char* reference_nonspace(const char* b, const char* e)
+    {
+        for (; b != e && scn::detail::is_space(*b); ++b) {
+        }
+        return b;
+    }
+    const char* reference_non_ascii(const char* b, const char* e)
+    {
+        for (; b != e && static_cast<unsigned char>(*b) < 0x80; ++b) {
+        }
+        return b;
+    }
+
+    // Every level the CPU supports, so that every variant gets run
+    std::vector<scn::detail::simd_level> supported_levels()
+    {
+        using scn::detail::simd_level;
+        std::vector<simd_level> ret;
+        for (auto l : {simd_level::none, simd_level::sse2, simd_level::sse42,
+                       simd_level::avx2, simd_level::avx512}) {
+            if (l <= scn::detail::detected_simd_level()) {
+                ret.push_back(l);
+            }
+        }
+        return ret;
+    }
+
+    struct simd_level_guard {
+        scn::detail::simd_level prev{scn::detail::active_simd_level()};
+        ~simd_level_guard()
+        {
+            scn::detail::set_simd_level(prev);
+        }
+    };
+}  // namespace
+
+TEST_CASE("simd level")
+{
+    simd_level_guard guard{};
+    for (auto l : supported_levels()) {
+        CHECK(scn::detail::set_simd_level(l) == l);
+        CHECK(scn::detail::active_simd_level() == l);
+    }
+    CHECK(scn::detail::set_simd_level(scn::detail::simd_level::avx512) ==
+          scn::detail::detected_simd_level());
+}
+
+TEST_CASE("simd kernels")
+{
+    simd_level_guard guard{};
+
+    // Every possible byte value, at every position, in every length around
+    // the block sizes
+    const size_t lengths[] = {0, 1, 15, 16, 17, 31, 32, 33, 63, 64, 65, 130};
+    std::vector<char> buf(160);
+    for (auto l : supported_levels()) {
+        scn::detail::set_simd_level(l);
+        CAPTURE(static_cast<int>(l));
+
+        for (int ch = 0; ch < 256; ++ch) {
+            for (size_t len : lengths) {
+                for (size_t pos = 0; pos < len; pos += (pos < 70 ? 1 : 13)) {
+                    std::fill(buf.begin(), buf.end(), 'a');
+                    buf[pos] = static_cast<char>(ch);
+                    const auto b = buf.data();
+                    const auto e = b + len;
+
+                    REQUIRE(scn::detail::find_classic_space(b, e) ==
+                            reference_space(b, e));
+                    REQUIRE(scn::detail::find_char(
+                                b, e, static_cast<char>(ch)) ==
+                            std::find(b, e, static_cast<char>(ch)));
+                    REQUIRE(scn::detail::find_non_ascii(b, e) ==
+                            reference_non_ascii(b, e));
+
+                    std::fill(buf.begin(), buf.end(), ' ');
+                    buf[pos] = static_cast<char>(ch);
+                    REQUIRE(scn::detail::find_classic_nonspace(b, e) ==
+                            reference_nonspace(b, e));
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("simd scanning")
+{
+    simd_level_guard guard{};
+
+    std::string source = " \t\n\v\f\r";
+    for (int i = 0; i < 10; ++i) {
+        source += std::string(static_cast<size_t>(i * 7), ' ') + "word" +
+                  std::to_string(i) + std::string(static_cast<size_t>(i), '\n');
+    }
+
+    for (auto l : supported_levels()) {
+        scn::detail::set_simd_level(l);
+        CAPTURE(static_cast<int>(l));
+
+        auto result = scn::make_result(source);
+        std::string word;
+        for (int i = 0; i < 10; ++i) {
+            result = scn::scan_default(result.range(), word);
+            CHECK(result);
+            CHECK(word == "word" + std::to_string(i));
+        }
+
+        std::string line;
+        auto lines = scn::make_result(source);
+        lines = scn::getline(lines.range(), line);
+        CHECK(lines);
+        CHECK(line == " \t");
+    }
+}
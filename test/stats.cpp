@@ -0,0 +1,87 @@
+// Copyright 2017 Elias Kosunen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// This file is a part of scnlib:
+//     https://github.com/eliaskosunen/scnlib
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "test.h"
+
+TEST_CASE("scan_stats aggregation")
+{
+    scn::scan_stats a{};
+    a.code_units_read = 3;
+    a.rollbacks = 1;
+
+    scn::scan_stats b{};
+    b.code_units_read = 4;
+    b.putback_calls = 2;
+
+    auto c = a + b;
+    CHECK(c.code_units_read == 7);
+    CHECK(c.rollbacks == 1);
+    CHECK(c.putback_calls == 2);
+
+    a += b;
+    CHECK(a.code_units_read == 7);
+}
+
+#if SCN_ENABLE_STATS
+
+TEST_CASE("scan_stats")
+{
+    scn::reset_scan_stats();
+
+    int i{};
+    auto ret = scn::scan("  123 abc", "{}", i);
+    CHECK(ret);
+    CHECK(i == 123);
+
+    auto stats = scn::get_scan_stats();
+    CHECK(stats.whitespace_skipped == 2);
+    CHECK(stats.code_units_read >= 5);
+    CHECK(stats.rollbacks == 0);
+
+    ret = scn::scan(ret.range(), "{}", i);
+    CHECK(!ret);
+    CHECK(ret.range_as_string() == " abc");
+
+    stats = scn::get_scan_stats();
+    CHECK(stats.whitespace_skipped == 3);
+    CHECK(stats.rollbacks >= 1);
+    CHECK(stats.rollback_code_units >= 1);
+
+    scn::reset_scan_stats();
+    stats = scn::get_scan_stats();
+    CHECK(stats.code_units_read == 0);
+    CHECK(stats.rollbacks == 0);
+}
+
+#else
+
+TEST_CASE("scan_stats disabled")
+{
+    int i{};
+    auto ret = scn::scan("  123 abc", "{}", i);
+    CHECK(ret);
+    ret = scn::scan(ret.range(), "{}", i);
+    CHECK(!ret);
+
+    auto stats = scn::get_scan_stats();
+    CHECK(stats.code_units_read == 0);
+    CHECK(stats.whitespace_skipped == 0);
+    CHECK(stats.rollbacks == 0);
+}
+
+#endif
@@ -140,6 +140,17 @@ TEST_CASE_TEMPLATE("ignore", CharT, char, wchar_t)
         CHECK(ret.range().size() == 0);
     }
 
+    SUBCASE("ignore_until_n")
+    {
+        auto ret = scn::ignore_until_n(data, 2, CharT{0x0a});  // '\n'
+        CHECK(ret);
+        CHECK(ret.range_as_string() == widen<CharT>("ne1\nline2"));
+
+        ret = scn::ignore_until_n(ret.range(), 8, CharT{0x0a});
+        CHECK(ret);
+        CHECK(ret.range_as_string() == widen<CharT>("\nline2"));
+    }
+
     SUBCASE("empty range")
     {
         string_type s{};
@@ -123,6 +123,34 @@ TEST_CASE("value")
     CHECK(ret2.range_as_string() == "foo");
 }
 
+TEST_CASE("direct")
+{
+    int i{0};
+    double d{};
+    std::string s{};
+    auto ret = scn::scan_direct("42 3.14 foobar", i, d, s);
+    CHECK(ret);
+    CHECK(ret.empty());
+    CHECK(i == 42);
+    CHECK(d == doctest::Approx(3.14));
+    CHECK(s == "foobar");
+
+    ret = scn::scan_direct("1 foo", i, d);
+    CHECK(!ret);
+    CHECK(ret.error() == scn::error::invalid_scanned_value);
+    CHECK(ret.range_as_string() == "1 foo");
+    CHECK(i == 1);
+
+    auto cmp = scn::scan_default("1", i, d);
+    ret = scn::scan_direct("1", i, d);
+    CHECK(ret.error() == cmp.error());
+    CHECK(ret.range_as_string() == cmp.range_as_string());
+
+    ret = scn::scan_direct("123 456", scn::discard<int>(), i);
+    CHECK(ret);
+    CHECK(i == 456);
+}
+
 TEST_CASE("temporary")
 {
     struct temporary {
@@ -164,6 +192,19 @@ TEST_CASE("enumerated arguments")
     CHECK(s == "text");
 }
 
+TEST_CASE("argument types")
+{
+    int i{};
+    std::string s{};
+    auto range = scn::wrap(scn::string_view{"42 text"});
+    auto store = scn::make_args_for(range, scn::string_view{"{} {}"}, i, s);
+    auto args = scn::basic_args<char>{store};
+
+    CHECK(args.get(0).type() == scn::detail::int_type);
+    CHECK(args.get(0).is_integral());
+    CHECK(args.get(1).type() == scn::detail::string_type);
+}
+
 TEST_CASE("format string literal mismatch")
 {
     std::string str;
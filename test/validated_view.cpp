@@ -0,0 +1,127 @@
+// Copyright 2017 Elias Kosunen
+//
+// Licensed under the Apache License, Version 2.0 (the "License{");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// This file is a part of scnlib:
+//     https://github.com/eliaskosunen/scnlib
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "test.h"
+
+TEST_CASE("validate_utf8")
+{
+    CHECK(scn::validate_utf8(std::string{"aä€🙂"}));
+    CHECK(scn::validate_utf8(std::string{}));
+    CHECK(scn::validate_utf8("plain ascii"));
+
+    for (auto invalid : {
+             "\x80",              // lone continuation byte
+             "a\xc3",             // truncated
+             "\xe2\x82",          // truncated
+             "\xc0\x80",          // overlong
+             "\xe0\x80\x80",      // overlong
+             "\xed\xa0\x80",      // surrogate
+             "\xf4\x90\x80\x80",  // > U+10FFFF
+             "\xff",
+         }) {
+        CAPTURE(invalid);
+        auto ret = scn::validate_utf8(std::string{invalid});
+        CHECK(!ret);
+        CHECK(ret.error() == scn::error::invalid_encoding);
+    }
+
+    // Invalid sequence after a long run of ASCII
+    std::string long_str(200, 'a');
+    for (size_t i = 0; i < long_str.size(); i += 7) {
+        auto s = long_str;
+        s[i] = '\xc3';
+        CAPTURE(i);
+        CHECK(!scn::validate_utf8(s));
+        s[i] = '\x80';
+        CHECK(!scn::validate_utf8(s));
+    }
+}
+
+TEST_CASE("validate_ascii")
+{
+    CHECK(scn::validate_ascii(std::string{"abc 123\n"}));
+    CHECK(!scn::validate_ascii(std::string{"abc ä"}));
+    CHECK(scn::validate_ascii(std::wstring{L"abc"}));
+    CHECK(!scn::validate_ascii(std::wstring{L"abc ä"}));
+}
+
+TEST_CASE("valid_utf8_view")
+{
+    std::string source{"aä 123 €🙂 word"};
+    auto view = scn::validate_utf8(source);
+    REQUIRE(view);
+
+    using wrapped = scn::range_wrapper_for_t<scn::valid_utf8_view>;
+    static_assert(wrapped::assume_valid_encoding, "");
+    static_assert(!wrapped::assume_ascii, "");
+    static_assert(
+        !scn::range_wrapper_for_t<scn::string_view>::assume_valid_encoding,
+        "");
+
+    std::string s;
+    int i{};
+    auto ret = scn::scan(view.value(), "{} {}", s, i);
+    CHECK(ret);
+    CHECK(s == "aä");
+    CHECK(i == 123);
+
+    scn::code_point cp{};
+    ret = scn::scan(ret.range(), " {}", cp);
+    CHECK(ret);
+    CHECK(cp == scn::make_code_point(0x20ac));
+
+    std::string rest;
+    ret = scn::getline(ret.range(), rest);
+    CHECK(ret);
+    CHECK(rest == "🙂 word");
+    CHECK(ret.empty());
+
+    // The view type is kept, so that the next scan is also unchecked
+    static_assert(std::is_same<decltype(ret.reconstruct()),
+                               scn::valid_utf8_view>::value,
+                  "");
+}
+
+TEST_CASE("ascii_view")
+{
+    auto view = scn::ascii_only("123 word\nnext line");
+
+    using wrapped = scn::range_wrapper_for_t<scn::ascii_view>;
+    static_assert(wrapped::assume_valid_encoding, "");
+    static_assert(wrapped::assume_ascii, "");
+
+    int i{};
+    std::string s;
+    auto ret = scn::scan(view, "{} {}", i, s);
+    CHECK(ret);
+    CHECK(i == 123);
+    CHECK(s == "word");
+
+    ret = scn::getline(ret.range(), s);
+    CHECK(ret);
+    CHECK(s.empty());
+
+    ret = scn::getline(ret.range(), s);
+    CHECK(ret);
+    CHECK(s == "next line");
+    CHECK(ret.empty());
+
+    ret = scn::scan_default(ret.range(), s);
+    CHECK(!ret);
+    CHECK(ret.error() == scn::error::end_of_range);
+}